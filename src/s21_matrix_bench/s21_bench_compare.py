@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON result files.
+
+    s21_bench_compare.py BASELINE.json CONTENDER.json [--threshold 0.10]
+
+Benchmarks are matched by name. When a file holds repetitions, the median
+aggregate is used. Every benchmark whose time grew by more than the
+threshold is flagged as a regression, and the script then exits with 1, so
+it can gate a change in CI.
+"""
+
+import argparse
+import json
+import sys
+
+# Seconds per unit of the "time_unit" field.
+UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def pretty(seconds):
+    for unit in ("s", "ms", "us", "ns"):
+        if seconds >= UNITS[unit] or unit == "ns":
+            return f"{seconds / UNITS[unit]:.3f}{unit}"
+
+
+def load(path, metric):
+    with open(path) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    times = {}
+    for b in benchmarks:
+        if b.get("error_occurred"):
+            continue
+        name = b.get("run_name", b["name"])
+        aggregate = b.get("aggregate_name")
+        if aggregate not in (None, "median"):
+            continue
+        # A median beats the individual repetitions of the same benchmark.
+        if aggregate is None and name in times and times[name][1]:
+            continue
+        seconds = b[metric] * UNITS[b.get("time_unit", "ns")]
+        times[name] = (seconds, aggregate == "median")
+    return {name: seconds for name, (seconds, _) in times.items()}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown flagged as a regression")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"),
+                        default="real_time")
+    args = parser.parse_args()
+
+    old = load(args.baseline, args.metric)
+    new = load(args.contender, args.metric)
+    regressions = 0
+    width = max((len(name) for name in old), default=10)
+    print(f"{'Benchmark':<{width}} {'Old':>12} {'New':>12} {'Change':>8}")
+    for name, before in old.items():
+        if name not in new:
+            print(f"{name:<{width}} {'missing in contender':>34}")
+            continue
+        after = new[name]
+        change = after / before - 1.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}} {pretty(before):>12} {pretty(after):>12}"
+              f" {change:>+8.1%}{flag}")
+    for name in new.keys() - old.keys():
+        print(f"{name:<{width}} {'new in contender':>34}")
+
+    if regressions:
+        print(f"\n{regressions} regression(s) above {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
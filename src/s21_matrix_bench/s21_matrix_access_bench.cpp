@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Element access throughput: summing every element of an n x n matrix
+// through each access path. The checked and unchecked policies are
+// measured side by side through at<>(); operator() follows the build's
+// default policy (make bench UNCHECKED=1 switches it).
+
+static S21Matrix Filled(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m.at<S21UncheckedAccess>(i, j) = i ^ j;
+  return m;
+}
+
+static void SetItems(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * state.range(0) *
+                          state.range(0));
+}
+
+static void BM_GetElement(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix m = Filled(n);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) sum += m.get_element(i, j);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+static void BM_Parentheses(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix m = Filled(n);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) sum += m(i, j);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+template <typename Access>
+static void BM_At(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix m = Filled(n);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) sum += m.at<Access>(i, j);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+static void BM_RowPointer(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix m = Filled(n);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+      const double *row = m.row(i);
+      for (int j = 0; j < n; ++j) sum += row[j];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+static void BM_Data(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix m = Filled(n);
+  for (auto _ : state) {
+    const double *data = m.data();
+    const int stride = m.get_stride();
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) sum += data[i * stride + j];
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+BENCHMARK(BM_GetElement)->Arg(64)->Arg(1024);
+BENCHMARK(BM_Parentheses)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_At, S21CheckedAccess)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_At, S21UncheckedAccess)->Arg(64)->Arg(1024);
+BENCHMARK(BM_RowPointer)->Arg(64)->Arg(1024);
+BENCHMARK(BM_Data)->Arg(64)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_async.h"
+
+namespace async = s21::async;
+
+// Four independent n x n products summed, called one after the other and
+// as one graph, and an elementwise chain step by step against its fused
+// graph. The products only overlap with more than one core.
+
+static S21Matrix Filled(int n, int seed) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = ((i * 7 + j * 3 + seed) % 11) - 5;
+  return m;
+}
+
+static void BM_EagerBranches(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n, 1), b = Filled(n, 2);
+  for (auto _ : state) {
+    S21Matrix result = a * b;
+    result.SumMatrix(b * a);
+    result.SumMatrix(a * a);
+    result.SumMatrix(b * b);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+BENCHMARK(BM_EagerBranches)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+
+static void BM_AsyncBranches(benchmark::State &state) {
+  const int n = state.range(0);
+  async::Future<double> a = Filled(n, 1), b = Filled(n, 2);
+  for (auto _ : state) {
+    auto result = async::Sum(async::Sum(async::Mul(a, b), async::Mul(b, a)),
+                             async::Sum(async::Mul(a, a), async::Mul(b, b)));
+    benchmark::DoNotOptimize(result.get().data());
+  }
+}
+BENCHMARK(BM_AsyncBranches)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+
+static void BM_EagerChain(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n, 1), b = Filled(n, 2), c = Filled(n, 3);
+  for (auto _ : state) {
+    S21Matrix result = a;
+    result.MulNumber(2);
+    result.SubMatrix(b);
+    S21Matrix scaled = c;
+    scaled.MulNumber(0.5);
+    result.SumMatrix(scaled);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+BENCHMARK(BM_EagerChain)->Arg(1024)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+static void BM_AsyncChain(benchmark::State &state) {
+  const int n = state.range(0);
+  async::Future<double> a = Filled(n, 1), b = Filled(n, 2), c = Filled(n, 3);
+  for (auto _ : state) {
+    auto result = async::Sum(async::Sub(async::Scale(a, 2), b),
+                             async::Scale(c, 0.5));
+    benchmark::DoNotOptimize(result.get().data());
+  }
+}
+BENCHMARK(BM_AsyncChain)->Arg(1024)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
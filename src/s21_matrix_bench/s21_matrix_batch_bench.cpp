@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../s21_matrix_plus/s21_matrix_batch.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// 4096 small matrices, one S21Matrix call per member against one batched
+// call over the interleaved batch.
+
+static const int kCount = 4096;
+
+static S21Matrix Member(int n, int seed) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      m(i, j) = i == j ? n + 1.0 : ((i * 3 + j + seed) % 5) - 2;
+  return m;
+}
+
+static std::vector<S21Matrix> Members(int n) {
+  std::vector<S21Matrix> members;
+  for (int k = 0; k < kCount; ++k) members.push_back(Member(n, k));
+  return members;
+}
+
+static S21MatrixBatch Batch(int n) {
+  S21MatrixBatch batch(kCount, n, n);
+  for (int k = 0; k < kCount; ++k) batch.Set(k, Member(n, k));
+  return batch;
+}
+
+static void BM_LoopMul(benchmark::State &state) {
+  std::vector<S21Matrix> a = Members(state.range(0)), b = a;
+  for (auto _ : state)
+    for (int k = 0; k < kCount; ++k)
+      benchmark::DoNotOptimize(a[k] * b[k]);
+}
+BENCHMARK(BM_LoopMul)->Arg(3)->Arg(4);
+
+static void BM_BatchMul(benchmark::State &state) {
+  S21MatrixBatch a = Batch(state.range(0)), b = a;
+  for (auto _ : state) benchmark::DoNotOptimize(a * b);
+}
+BENCHMARK(BM_BatchMul)->Arg(3)->Arg(4);
+
+// Rewriting an element with its own value still counts as a change, so
+// every member is factored again each iteration, as the batch is, instead
+// of returning its cached result.
+static void BM_LoopDeterminant(benchmark::State &state) {
+  const int n = state.range(0);
+  std::vector<S21Matrix> a = Members(n);
+  for (auto _ : state)
+    for (int k = 0; k < kCount; ++k) {
+      a[k].set_element(0, 0, n + 1.0);
+      benchmark::DoNotOptimize(a[k].Determinant());
+    }
+}
+BENCHMARK(BM_LoopDeterminant)->Arg(3)->Arg(4);
+
+static void BM_BatchDeterminant(benchmark::State &state) {
+  S21MatrixBatch a = Batch(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+}
+BENCHMARK(BM_BatchDeterminant)->Arg(3)->Arg(4);
+
+static void BM_LoopInverse(benchmark::State &state) {
+  const int n = state.range(0);
+  std::vector<S21Matrix> a = Members(n);
+  for (auto _ : state)
+    for (int k = 0; k < kCount; ++k) {
+      a[k].set_element(0, 0, n + 1.0);
+      benchmark::DoNotOptimize(a[k].InverseMatrix());
+    }
+}
+BENCHMARK(BM_LoopInverse)->Arg(3)->Arg(4);
+
+static void BM_BatchInverse(benchmark::State &state) {
+  S21MatrixBatch a = Batch(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(a.InverseMatrix());
+}
+BENCHMARK(BM_BatchInverse)->Arg(3)->Arg(4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_counters.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Cost of one probe, and small operations whose time the probes would
+// dominate; build with and without INSTRUMENT=1 and compare the two runs
+// with bench_compare.
+
+static void BM_Probe(benchmark::State &state) {
+  for (auto _ : state) {
+    S21OpProbe probe(S21Op::kSumMatrix, 4, 4);
+    probe.AddFlops(16);
+  }
+}
+BENCHMARK(BM_Probe);
+
+static void BM_ProbeAllocated(benchmark::State &state) {
+  for (auto _ : state) {
+    S21OpProbe probe(S21Op::kMulMatrix, 4, 4);
+    S21OpProbe::CountAllocated(256);
+  }
+}
+BENCHMARK(BM_ProbeAllocated);
+
+static void BM_Snapshot(benchmark::State &state) {
+  { S21OpProbe probe(S21Op::kSumMatrix, 4, 4); }
+  for (auto _ : state) benchmark::DoNotOptimize(S21Counters::SnapshotJson());
+}
+BENCHMARK(BM_Snapshot);
+
+static void BM_SumSmall(benchmark::State &state) {
+  S21Matrix a(4, 4), b(4, 4);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+BENCHMARK(BM_SumSmall);
+
+static void BM_MulSmall(benchmark::State &state) {
+  S21Matrix a(4, 4), b(4, 4);
+  for (auto _ : state) benchmark::DoNotOptimize((a * b).data());
+}
+BENCHMARK(BM_MulSmall);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Fused (expression template) against unfused (one pass and one temporary
+// per operation) evaluation of r = a + 2b - c + d - 0.5e.
+
+static S21Matrix Filled(int n, double seed) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = seed + (i + j) % 7;
+  return m;
+}
+
+struct Operands {
+  S21Matrix a, b, c, d, e;
+  explicit Operands(int n)
+      : a(Filled(n, 1)),
+        b(Filled(n, 2)),
+        c(Filled(n, 3)),
+        d(Filled(n, 4)),
+        e(Filled(n, 5)) {}
+};
+
+static void SetBytes(benchmark::State &state) {
+  // Five operands read and one result written per evaluation.
+  state.SetBytesProcessed(state.iterations() * 6 * state.range(0) *
+                          state.range(0) * sizeof(double));
+}
+
+static void BM_Fused(benchmark::State &state) {
+  Operands o(state.range(0));
+  for (auto _ : state) {
+    S21Matrix r = o.a + o.b * 2.0 - o.c + o.d - o.e * 0.5;
+    benchmark::DoNotOptimize(r);
+  }
+  SetBytes(state);
+}
+
+static void BM_FusedIntoExisting(benchmark::State &state) {
+  Operands o(state.range(0));
+  S21Matrix r(state.range(0), state.range(0));
+  for (auto _ : state) {
+    r = o.a + o.b * 2.0 - o.c + o.d - o.e * 0.5;
+    benchmark::DoNotOptimize(r);
+  }
+  SetBytes(state);
+}
+
+static void BM_Unfused(benchmark::State &state) {
+  Operands o(state.range(0));
+  for (auto _ : state) {
+    S21Matrix b2(o.b);
+    b2.MulNumber(2.0);
+    S21Matrix r(o.a);
+    r.SumMatrix(b2);
+    S21Matrix r2(r);
+    r2.SubMatrix(o.c);
+    S21Matrix r3(r2);
+    r3.SumMatrix(o.d);
+    S21Matrix e2(o.e);
+    e2.MulNumber(0.5);
+    S21Matrix r4(r3);
+    r4.SubMatrix(e2);
+    benchmark::DoNotOptimize(r4);
+  }
+  SetBytes(state);
+}
+
+BENCHMARK(BM_Fused)->Arg(256)->Arg(1024)->Arg(4096)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_FusedIntoExisting)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Unfused)->Arg(256)->Arg(1024)->Arg(4096)->Unit(
+    benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_fixed.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Small transforms as fixed-size and as dynamic matrices: a product, a
+// determinant and an inverse per iteration.
+
+template <int N>
+static S21FixedMatrix<N, N> Transform() {
+  S21FixedMatrix<N, N> m;
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < N; ++j) m(i, j) = i == j ? N : (i + 2 * j) % 3 * 0.5;
+  return m;
+}
+
+template <int N>
+static void BM_Fixed(benchmark::State &state) {
+  S21FixedMatrix<N, N> a = Transform<N>(), b = Transform<N>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    S21FixedMatrix<N, N> c = a * b;
+    double det = c.Determinant();
+    S21FixedMatrix<N, N> inverse = c.InverseMatrix();
+    benchmark::DoNotOptimize(det);
+    benchmark::DoNotOptimize(inverse);
+  }
+}
+
+template <int N>
+static void BM_Dynamic(benchmark::State &state) {
+  S21Matrix a = Transform<N>().ToMatrix(), b(a);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    double det = c.Determinant();
+    S21Matrix inverse = c.InverseMatrix();
+    benchmark::DoNotOptimize(det);
+    benchmark::DoNotOptimize(inverse.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Fixed, 2);
+BENCHMARK_TEMPLATE(BM_Dynamic, 2);
+BENCHMARK_TEMPLATE(BM_Fixed, 3);
+BENCHMARK_TEMPLATE(BM_Dynamic, 3);
+BENCHMARK_TEMPLATE(BM_Fixed, 4);
+BENCHMARK_TEMPLATE(BM_Dynamic, 4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../s21_matrix_plus/s21_matrix_gemm.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// GEMM engine against the textbook i-j-k loop it replaced.
+// Arguments are {m, k, n}: C(m x n) = A(m x k) * B(k x n).
+
+static S21Matrix Filled(int rows, int cols) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j) m(i, j) = (i * 31 + j * 17) % 13 * 0.25;
+  return m;
+}
+
+static void SetFlops(benchmark::State &state) {
+  double flops = 2.0 * state.range(0) * state.range(1) * state.range(2);
+  state.counters["FLOP/s"] = benchmark::Counter(
+      flops, benchmark::Counter::kIsIterationInvariantRate,
+      benchmark::Counter::OneK::kIs1000);
+}
+
+static void BM_NaiveIJK(benchmark::State &state) {
+  int m = state.range(0), k = state.range(1), n = state.range(2);
+  std::vector<double> a(static_cast<size_t>(m) * k, 0.5);
+  std::vector<double> b(static_cast<size_t>(k) * n, 0.25);
+  std::vector<double> c(static_cast<size_t>(m) * n);
+  for (auto _ : state) {
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double sum = 0.0;
+        for (int p = 0; p < k; ++p) sum += a[i * k + p] * b[p * n + j];
+        c[i * n + j] = sum;
+      }
+    }
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state);
+}
+
+static void BM_MulMatrix(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0), state.range(1));
+  S21Matrix b = Filled(state.range(1), state.range(2));
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlops(state);
+}
+
+// Kernel only, into a preallocated C: excludes the result allocation that
+// dominates operator* for very flat shapes such as 4096 x 16 x 4096.
+static void BM_GemmKernel(benchmark::State &state) {
+  int m = state.range(0), k = state.range(1), n = state.range(2);
+  std::vector<double> a(static_cast<size_t>(m) * k, 0.5);
+  std::vector<double> b(static_cast<size_t>(k) * n, 0.25);
+  std::vector<double> c(static_cast<size_t>(m) * n);
+  for (auto _ : state) {
+    s21::Gemm(m, n, k, 1.0, a.data(), k, b.data(), n, c.data(), n);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state);
+}
+
+static void GemmShapes(benchmark::internal::Benchmark *bench) {
+  for (int n : {64, 128, 256, 512, 1024}) bench->Args({n, n, n});
+  // Skinny shapes: tall-skinny times short-wide, inner products, panels.
+  bench->Args({4096, 16, 4096});
+  bench->Args({16, 4096, 16});
+  bench->Args({4096, 64, 64});
+  bench->Args({64, 4096, 1024});
+  bench->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_NaiveIJK)->Apply(GemmShapes);
+BENCHMARK(BM_MulMatrix)->Apply(GemmShapes);
+BENCHMARK(BM_GemmKernel)->Apply(GemmShapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../s21_matrix_plus/s21_matrix_io.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Startup cost of getting at a saved n x n matrix: mapping it and touching
+// one element, mapping it and copying it into an owned matrix, and the
+// text parsing it replaces.
+
+static std::string PathFor(int n, const char *kind) {
+  return "/tmp/s21_matrix_io_bench_" + std::to_string(n) + kind;
+}
+
+static S21Matrix Filled(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = (i * 7 + j) % 13 * 0.5;
+  return m;
+}
+
+static void BM_Save(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix m = Filled(n);
+  std::string path = PathFor(n, ".bin");
+  for (auto _ : state) S21MatrixWriter::Save(m, path);
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+}
+BENCHMARK(BM_Save)->Arg(256)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+static void BM_MapTouchOne(benchmark::State &state) {
+  const int n = state.range(0);
+  std::string path = PathFor(n, ".bin");
+  S21MatrixWriter::Save(Filled(n), path);
+  for (auto _ : state) {
+    S21MappedMatrix mapped(path);
+    benchmark::DoNotOptimize(mapped(n / 2, n / 2));
+  }
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_MapTouchOne)->Arg(256)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+static void BM_MapCopy(benchmark::State &state) {
+  const int n = state.range(0);
+  std::string path = PathFor(n, ".bin");
+  S21MatrixWriter::Save(Filled(n), path);
+  for (auto _ : state) {
+    S21MappedMatrix mapped(path);
+    S21Matrix copy = mapped.View();
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_MapCopy)->Arg(256)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+static void BM_ParseText(benchmark::State &state) {
+  const int n = state.range(0);
+  std::string path = PathFor(n, ".txt");
+  {
+    S21Matrix m = Filled(n);
+    std::ofstream out(path);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) out << m(i, j) << (j + 1 < n ? ' ' : '\n');
+  }
+  for (auto _ : state) {
+    std::ifstream in(path);
+    S21Matrix m(n, n);
+    double value;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) {
+        in >> value;
+        m.set_element(i, j, value);
+      }
+    benchmark::DoNotOptimize(m.data());
+  }
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_ParseText)->Arg(256)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,319 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Every public S21Matrix operation on n x n matrices, n = 2, 8, ..., 2048
+// and 4096. Run with --benchmark_filter to pick a subset; make bench writes
+// the results as JSON next to the binaries for s21_bench_compare.py.
+
+// Diagonally dominant, so the inverse and complements take the LU path
+// instead of failing or falling back to minors.
+static S21Matrix Filled(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      m(i, j) = i == j ? n : (i * 31 + j * 17) % 13 * 0.01;
+  return m;
+}
+
+// Elements touched per iteration, reported as items/s.
+static void SetItems(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * state.range(0) *
+                          state.range(0));
+}
+
+static void BM_Construct(benchmark::State &state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    S21Matrix m(n, n);
+    benchmark::DoNotOptimize(m.data());
+  }
+  SetItems(state);
+}
+
+static void BM_CopyConstruct(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    S21Matrix m(a);
+    benchmark::DoNotOptimize(m.data());
+  }
+  SetItems(state);
+}
+
+static void BM_CopyAssign(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    b = a;
+    benchmark::DoNotOptimize(b.data());
+  }
+  SetItems(state);
+}
+
+static void BM_Move(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    S21Matrix b(std::move(a));
+    a = std::move(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+
+static void BM_GetSetElement(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        a.set_element(i, j, a.get_element(i, j) + 1.0);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_SetRowsCols(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n);
+  for (auto _ : state) {
+    a.set_rows(n + 1);
+    a.set_cols(n + 9);
+    a.set_rows(n);
+    a.set_cols(n);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_EqMatrix(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  SetItems(state);
+}
+
+static void BM_SumMatrix(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_SubMatrix(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_MulNumber(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    a.MulNumber(1.0);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_Axpy(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    a.Axpy(0.5, b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_OperatorPlus(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    S21Matrix c = a + b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetItems(state);
+}
+
+static void BM_OperatorMinus(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    S21Matrix c = a - b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetItems(state);
+}
+
+static void BM_OperatorScale(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    S21Matrix c = a * 2.0;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetItems(state);
+}
+
+static void BM_MulMatrix(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetItems(state);
+}
+
+static void BM_MulAssign(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b(a);
+  for (auto _ : state) {
+    a.MulNumber(1.0 / state.range(0));
+    a *= b;
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+static void BM_Transpose(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    S21Matrix t = a.Transpose();
+    benchmark::DoNotOptimize(t.data());
+  }
+  SetItems(state);
+}
+
+static void BM_TransposeInPlace(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+// Reading the transpose through the view into an existing matrix.
+static void BM_TransposedView(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), t(a);
+  for (auto _ : state) {
+    t = a.TransposedView();
+    benchmark::DoNotOptimize(t.data());
+  }
+  SetItems(state);
+}
+
+static void BM_Minor(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), minor;
+  for (auto _ : state) {
+    a.Minor(minor, 0, 0);
+    benchmark::DoNotOptimize(minor.data());
+  }
+  SetItems(state);
+}
+
+// Rewriting an element with its own value still counts as a change, so
+// these factor the matrix every iteration; the Cached variants below
+// repeat the call on an unchanged matrix.
+static void BM_Determinant(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    a.set_element(0, 0, state.range(0));
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  SetItems(state);
+}
+
+static void BM_InverseMatrix(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    a.set_element(0, 0, state.range(0));
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  SetItems(state);
+}
+
+static void BM_CalcComplements(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    a.set_element(0, 0, state.range(0));
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.data());
+  }
+  SetItems(state);
+}
+
+static void BM_DeterminantCached(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+  SetItems(state);
+}
+
+static void BM_InverseMatrixCached(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0));
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  SetItems(state);
+}
+
+// The same operations per element type: float halves the memory traffic
+// and doubles the SIMD width of double.
+template <typename T>
+static void BM_SumMatrixOf(benchmark::State &state) {
+  const int n = state.range(0);
+  S21BasicMatrix<T> a(n, n), b(n, n);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetItems(state);
+}
+
+template <typename T>
+static void BM_MulMatrixOf(benchmark::State &state) {
+  const int n = state.range(0);
+  S21BasicMatrix<T> a(n, n), b(n, n);
+  for (auto _ : state) {
+    S21BasicMatrix<T> c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetItems(state);
+}
+
+#define S21_SIZES RangeMultiplier(4)->Range(2, 4096)
+#define S21_CUBIC_SIZES S21_SIZES->Unit(benchmark::kMicrosecond)
+
+BENCHMARK(BM_Construct)->S21_SIZES;
+BENCHMARK(BM_CopyConstruct)->S21_SIZES;
+BENCHMARK(BM_CopyAssign)->S21_SIZES;
+BENCHMARK(BM_Move)->S21_SIZES;
+BENCHMARK(BM_GetSetElement)->S21_SIZES;
+BENCHMARK(BM_SetRowsCols)->S21_SIZES;
+BENCHMARK(BM_EqMatrix)->S21_SIZES;
+BENCHMARK(BM_SumMatrix)->S21_SIZES;
+BENCHMARK(BM_SubMatrix)->S21_SIZES;
+BENCHMARK(BM_MulNumber)->S21_SIZES;
+BENCHMARK(BM_Axpy)->S21_SIZES;
+BENCHMARK(BM_OperatorPlus)->S21_SIZES;
+BENCHMARK(BM_OperatorMinus)->S21_SIZES;
+BENCHMARK(BM_OperatorScale)->S21_SIZES;
+BENCHMARK(BM_Transpose)->S21_SIZES;
+BENCHMARK(BM_TransposeInPlace)->S21_SIZES;
+BENCHMARK(BM_TransposedView)->S21_SIZES;
+BENCHMARK(BM_Minor)->S21_SIZES;
+BENCHMARK(BM_MulMatrix)->S21_CUBIC_SIZES;
+BENCHMARK(BM_MulAssign)->S21_CUBIC_SIZES;
+BENCHMARK(BM_Determinant)->S21_CUBIC_SIZES;
+BENCHMARK(BM_InverseMatrix)->S21_CUBIC_SIZES;
+BENCHMARK(BM_CalcComplements)->S21_CUBIC_SIZES;
+BENCHMARK(BM_DeterminantCached)->S21_SIZES;
+BENCHMARK(BM_InverseMatrixCached)->S21_SIZES;
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, float)->S21_SIZES;
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, double)->S21_SIZES;
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, long double)->S21_SIZES;
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, std::complex<double>)->S21_SIZES;
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, float)->S21_CUBIC_SIZES;
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, double)->S21_CUBIC_SIZES;
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, long double)->S21_CUBIC_SIZES;
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, std::complex<double>)->S21_CUBIC_SIZES;
+
+BENCHMARK_MAIN();
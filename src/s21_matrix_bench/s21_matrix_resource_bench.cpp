@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_resource.h"
+
+// A request that builds and drops several n x n temporaries, with matrix
+// storage from the global heap, a pool and a per-request arena.
+
+static S21Matrix Filled(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = i == j ? n : (i + j) % 3;
+  return m;
+}
+
+static double Request(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix sum = a + b * 2.0;
+  S21Matrix product = sum * a;
+  S21Matrix minor(a.get_rows() - 1, a.get_cols() - 1);
+  S21Matrix(a).Minor(minor, 0, 0);
+  return product(0, 0) + minor(0, 0);
+}
+
+static void BM_RequestHeap(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b = Filled(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(Request(a, b));
+}
+BENCHMARK(BM_RequestHeap)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_RequestPool(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b = Filled(state.range(0));
+  S21PoolResource pool;
+  S21MatrixResourceScope scope(&pool);
+  for (auto _ : state) benchmark::DoNotOptimize(Request(a, b));
+}
+BENCHMARK(BM_RequestPool)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_RequestArena(benchmark::State &state) {
+  S21Matrix a = Filled(state.range(0)), b = Filled(state.range(0));
+  S21ArenaResource arena;
+  for (auto _ : state) {
+    {
+      S21MatrixResourceScope scope(&arena);
+      benchmark::DoNotOptimize(Request(a, b));
+    }
+    arena.Release();
+  }
+}
+BENCHMARK(BM_RequestArena)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_solve.h"
+
+// A * x = b with 8 right-hand sides: inverse then product, against Solve
+// through LU and Cholesky, and against a solver factored once.
+
+static S21Matrix Spd(int n) {
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      a(i, j) = i == j ? n : 1.0 / (1 + (i > j ? i - j : j - i));
+  return a;
+}
+
+static S21Matrix Rhs(int n) {
+  S21Matrix b(n, 8);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < 8; ++j) b(i, j) = (i + j) % 5;
+  return b;
+}
+
+// Rewriting an element with its own value still counts as a change, so
+// the inverse is computed every iteration rather than taken from the cache.
+static void BM_InverseThenMul(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Spd(n), b = Rhs(n);
+  for (auto _ : state) {
+    a.set_element(0, 0, n);
+    benchmark::DoNotOptimize(a.InverseMatrix() * b);
+  }
+}
+BENCHMARK(BM_InverseThenMul)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_SolveLu(benchmark::State &state) {
+  S21Matrix a = Spd(state.range(0)), b = Rhs(state.range(0));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a.Solve(b, S21SolveHint::kGeneral));
+}
+BENCHMARK(BM_SolveLu)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_SolveCholesky(benchmark::State &state) {
+  S21Matrix a = Spd(state.range(0)), b = Rhs(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Solve(b));
+}
+BENCHMARK(BM_SolveCholesky)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_SolveFactored(benchmark::State &state) {
+  S21Matrix a = Spd(state.range(0)), b = Rhs(state.range(0));
+  S21LinearSolver solver(a);
+  for (auto _ : state) benchmark::DoNotOptimize(solver.Solve(b));
+}
+BENCHMARK(BM_SolveFactored)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_LeastSquares(benchmark::State &state) {
+  S21Matrix a = Spd(2 * state.range(0)), b = Rhs(2 * state.range(0));
+  a.set_cols(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(a.LeastSquares(b));
+}
+BENCHMARK(BM_LeastSquares)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_sparse.h"
+
+// Sparse against dense products of a kN x kN matrix whose density is the
+// benchmark argument in parts per thousand. Dense work does not depend on
+// the density; the crossover is where the sparse time reaches it.
+
+static constexpr int kN = 1024;
+static constexpr int kRhsCols = 64;
+
+static S21SparseMatrix Random(int per_mille) {
+  std::mt19937 gen(21);
+  std::uniform_int_distribution<int> index(0, kN - 1);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  S21SparseBuilder builder(kN, kN);
+  size_t count = static_cast<size_t>(kN) * kN * per_mille / 1000;
+  builder.Reserve(count);
+  for (size_t k = 0; k < count; ++k)
+    builder.Add(index(gen), index(gen), value(gen));
+  return builder.Build();
+}
+
+static S21Matrix Filled(int rows, int cols) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j) m(i, j) = (i + 2 * j) % 7 * 0.25;
+  return m;
+}
+
+static void Densities(benchmark::internal::Benchmark *b) {
+  for (int per_mille : {1, 10, 50, 100, 250, 500}) b->Arg(per_mille);
+}
+
+static void BM_SparseMulMatrix(benchmark::State &state) {
+  S21SparseMatrix a = Random(state.range(0));
+  S21Matrix b = Filled(kN, kRhsCols);
+  for (auto _ : state) benchmark::DoNotOptimize(a * b);
+  state.counters["nnz"] = a.NonZeros();
+}
+BENCHMARK(BM_SparseMulMatrix)->Apply(Densities)->Unit(benchmark::kMicrosecond);
+
+static void BM_DenseMulMatrix(benchmark::State &state) {
+  S21Matrix a = Random(state.range(0)).ToDense();
+  S21Matrix b = Filled(kN, kRhsCols);
+  for (auto _ : state) benchmark::DoNotOptimize(a * b);
+}
+BENCHMARK(BM_DenseMulMatrix)->Apply(Densities)->Unit(benchmark::kMicrosecond);
+
+static void BM_SparseMulVector(benchmark::State &state) {
+  S21SparseMatrix a = Random(state.range(0));
+  std::vector<double> x(kN, 0.5);
+  for (auto _ : state) benchmark::DoNotOptimize(a * x);
+}
+BENCHMARK(BM_SparseMulVector)->Apply(Densities)->Unit(benchmark::kMicrosecond);
+
+// The dense matrix-vector product is a kN x 1 right-hand side.
+static void BM_DenseMulVector(benchmark::State &state) {
+  S21Matrix a = Random(state.range(0)).ToDense();
+  S21Matrix x = Filled(kN, 1);
+  for (auto _ : state) benchmark::DoNotOptimize(a * x);
+}
+BENCHMARK(BM_DenseMulVector)->Apply(Densities)->Unit(benchmark::kMicrosecond);
+
+static void BM_SparseSumMatrix(benchmark::State &state) {
+  S21SparseMatrix a = Random(state.range(0)), b = a.Transpose();
+  for (auto _ : state) benchmark::DoNotOptimize(a + b);
+}
+BENCHMARK(BM_SparseSumMatrix)->Apply(Densities)->Unit(benchmark::kMicrosecond);
+
+static void BM_SparseTranspose(benchmark::State &state) {
+  S21SparseMatrix a = Random(state.range(0));
+  for (auto _ : state) benchmark::DoNotOptimize(a.Transpose());
+}
+BENCHMARK(BM_SparseTranspose)->Apply(Densities)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
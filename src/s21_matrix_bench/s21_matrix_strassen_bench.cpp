@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_strassen.h"
+
+// n x n products, classical GEMM against Strassen-Winograd with the
+// crossover given as the second argument.
+
+static S21Matrix Filled(int n, int seed) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = ((i * 7 + j * 3 + seed) % 11) - 5;
+  return m;
+}
+
+static void BM_Classical(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n, 1), b = Filled(n, 2);
+  for (auto _ : state) {
+    S21Matrix c = a;
+    c.MulMatrix(b, S21MulAlgorithm::kClassical);
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+BENCHMARK(BM_Classical)
+    ->Arg(512)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_Strassen(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n, 1), b = Filled(n, 2);
+  s21::SetStrassenCrossover(state.range(1));
+  for (auto _ : state) {
+    S21Matrix c = a;
+    c.MulMatrix(b, S21MulAlgorithm::kStrassen);
+    benchmark::DoNotOptimize(c.data());
+  }
+  s21::SetStrassenCrossover(s21::kStrassenCrossover);
+}
+BENCHMARK(BM_Strassen)
+    ->ArgsProduct({{512, 1024, 2048}, {128, 256, 512}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_text.h"
+
+// Text throughput on an n x n matrix held in memory, so the numbers are
+// parsing and formatting cost rather than disk speed. bytes_per_second is
+// the size of the text.
+
+static S21Matrix Filled(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = (i * 7 - j) / 3.0;
+  return m;
+}
+
+static std::string Csv(int n) {
+  std::ostringstream out;
+  S21MatrixText::WriteCsv(out, Filled(n));
+  return out.str();
+}
+
+static void BM_WriteCsv(benchmark::State &state) {
+  S21Matrix m = Filled(state.range(0));
+  size_t bytes = 0;
+  for (auto _ : state) {
+    std::ostringstream out;
+    S21MatrixText::WriteCsv(out, m);
+    bytes = out.tellp();
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_WriteCsv)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_ReadCsv(benchmark::State &state) {
+  std::string text = Csv(state.range(0));
+  S21TextOptions options;
+  options.parallel = state.range(1);
+  for (auto _ : state) {
+    std::istringstream in(text);
+    benchmark::DoNotOptimize(S21MatrixText::ReadCsv(in, options));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ReadCsv)
+    ->Args({1024, 0})
+    ->Args({1024, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// The hand-rolled parser the readers replace.
+static void BM_ReadCsvStream(benchmark::State &state) {
+  const int n = state.range(0);
+  std::string text = Csv(n);
+  for (auto _ : state) {
+    std::istringstream in(text);
+    S21Matrix m(n, n);
+    double value;
+    char comma;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) {
+        in >> value;
+        if (j + 1 < n) in >> comma;
+        m.set_element(i, j, value);
+      }
+    benchmark::DoNotOptimize(m.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ReadCsvStream)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_ReadMatrixMarket(benchmark::State &state) {
+  S21SparseMatrix sparse(Filled(state.range(0)));
+  std::ostringstream out;
+  S21MatrixText::WriteMatrixMarket(out, sparse);
+  std::string text = out.str();
+  for (auto _ : state) {
+    std::istringstream in(text);
+    benchmark::DoNotOptimize(S21MatrixText::ReadMatrixMarketSparse(in));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ReadMatrixMarket)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+
+#include "../s21_matrix_plus/s21_matrix_tiled.h"
+
+// n x n products and sums of disk-backed matrices with the cache budget
+// in MiB as the second argument, against the in-memory product. The files
+// sit in the page cache after the first iteration, so this measures the
+// tiling and copying overhead rather than the disk.
+
+static const char *kPaths[] = {"s21_tiled_bench_a.bin",
+                               "s21_tiled_bench_b.bin",
+                               "s21_tiled_bench_c.bin"};
+
+static S21Matrix Filled(int n, int seed) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = ((i * 7 + j * 3 + seed) % 11) - 5;
+  return m;
+}
+
+static void BM_InMemory(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n, 1), b = Filled(n, 2);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+BENCHMARK(BM_InMemory)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_TiledMul(benchmark::State &state) {
+  const int n = state.range(0);
+  S21TileCache cache(static_cast<size_t>(state.range(1)) << 20);
+  S21TiledMatrix a(kPaths[0], n, n, cache), b(kPaths[1], n, n, cache);
+  a.WriteBlock(0, 0, Filled(n, 1));
+  b.WriteBlock(0, 0, Filled(n, 2));
+  for (auto _ : state) {
+    S21TiledMatrix c = a.MulMatrix(b, kPaths[2]);
+    c.Flush();
+  }
+  state.counters["peak_MiB"] = cache.get_peak_bytes() / double(1 << 20);
+  for (const char *path : kPaths) std::remove(path);
+}
+BENCHMARK(BM_TiledMul)
+    ->ArgsProduct({{1024}, {2, 8, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_TiledSum(benchmark::State &state) {
+  const int n = state.range(0);
+  S21TileCache cache(static_cast<size_t>(state.range(1)) << 20);
+  S21TiledMatrix a(kPaths[0], n, n, cache), b(kPaths[1], n, n, cache);
+  a.WriteBlock(0, 0, Filled(n, 1));
+  b.WriteBlock(0, 0, Filled(n, 2));
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    a.Flush();
+  }
+  state.counters["peak_MiB"] = cache.get_peak_bytes() / double(1 << 20);
+  for (const char *path : kPaths) std::remove(path);
+}
+BENCHMARK(BM_TiledSum)
+    ->ArgsProduct({{2048}, {2, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
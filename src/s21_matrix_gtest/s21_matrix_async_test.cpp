@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "../s21_matrix_plus/s21_matrix_async.h"
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "s21_matrix_test_util.h"
+
+namespace async = s21::async;
+
+// Default resource counting the matrix storage alive, from any thread.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  CountingResource() : previous_(std::pmr::set_default_resource(this)) {}
+  ~CountingResource() override { std::pmr::set_default_resource(previous_); }
+
+  size_t live = 0, peak = 0, allocations = 0;
+
+ private:
+  std::pmr::memory_resource *previous_;
+  std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    void *p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    while (lock_.test_and_set()) {
+    }
+    live += bytes;
+    peak = std::max(peak, live);
+    ++allocations;
+    lock_.clear();
+    return p;
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    while (lock_.test_and_set()) {
+    }
+    live -= bytes;
+    lock_.clear();
+  }
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+static size_t Bytes(const S21Matrix &m) {
+  return static_cast<size_t>(m.get_rows()) * m.get_stride() * sizeof(double);
+}
+
+TEST(S21AsyncTest, MatchesEagerEvaluation) {
+  S21Matrix a = Filled(12, 9, 1), b = Filled(9, 12, 2);
+  S21Matrix c = Filled(12, 12, 3, 12);
+  auto x = async::Mul(a, b);
+  auto y = async::Inverse(c);
+  auto z = async::Sub(async::Sum(async::Scale(x, 2), async::Transpose(y)), c);
+  EXPECT_EQ(z.get_rows(), 12);
+  EXPECT_EQ(z.get_cols(), 12);
+  EXPECT_FALSE(z.ready());
+  S21Matrix expected = (a * b) * 2.0 + c.InverseMatrix().Transpose() - c;
+  EXPECT_TRUE(S21Matrix(z.get()) == expected);
+  EXPECT_TRUE(z.ready());
+  EXPECT_TRUE(x.ready());
+  EXPECT_TRUE(S21Matrix(x.get()) == a * b);
+  // Inputs are copied: changing an argument does not change the graph.
+  auto late = async::Mul(a, b);
+  a(0, 0) = 100;
+  EXPECT_TRUE(S21Matrix(late.get()) == x.get());
+}
+
+TEST(S21AsyncTest, ParallelBranches) {
+  S21ThreadPool pool(4);
+  pool.set_serial_threshold(0);
+  S21ThreadPoolScope scope(pool);
+  S21Matrix a = Filled(40, 40, 4), b = Filled(40, 40, 5);
+  // Shared by both roots, computed once.
+  auto shared = async::Mul(a, b);
+  std::vector<async::Future<double>> branches;
+  for (int i = 0; i < 8; ++i)
+    branches.push_back(async::Mul(async::Scale(shared, i + 1), a));
+  auto f = branches[0], g = async::Sub(shared, b);
+  for (int i = 1; i < 8; ++i) f = async::Sum(f, branches[i]);
+  async::Run({f, g});
+  EXPECT_TRUE(shared.ready());
+  EXPECT_TRUE(g.ready());
+  S21Matrix ab = a * b;
+  EXPECT_TRUE(S21Matrix(f.get()) == (ab * a) * 36.0);
+  EXPECT_TRUE(S21Matrix(g.get()) == ab - b);
+}
+
+// Chunks of one linear combination run on different workers.
+TEST(S21AsyncTest, ParallelLinearCombination) {
+  S21ThreadPool pool(4);
+  pool.set_serial_threshold(0);
+  S21ThreadPoolScope scope(pool);
+  S21Matrix a = Filled(200, 200, 1), b = Filled(200, 200, 2);
+  auto f = async::Sub(async::Scale(a, 3), async::Sum(a, b));
+  EXPECT_TRUE(S21Matrix(f.get()) == a * 2.0 - b);
+}
+
+TEST(S21AsyncTest, FusesElementwiseChains) {
+  CountingResource counting;
+  auto x = async::Future<double>(Filled(30, 20, 6));
+  auto y = async::Future<double>(Filled(30, 20, 7));
+  auto z = async::Future<double>(Filled(30, 20, 8));
+  auto f = async::Sum(async::Sub(async::Scale(x, 2), y), async::Scale(z, -1));
+  size_t before = counting.allocations;
+  const S21Matrix &result = f.get();
+  // One pass straight into the result, no temporaries.
+  EXPECT_EQ(counting.allocations - before, 1u);
+  EXPECT_TRUE(S21Matrix(result) == x.get() * 2.0 - y.get() - z.get());
+  // An inner node someone else holds is kept, and computed on its own.
+  auto held = async::Sum(x, y);
+  auto g = async::Scale(held, 3);
+  before = counting.allocations;
+  g.get();
+  EXPECT_EQ(counting.allocations - before, 2u);
+  EXPECT_TRUE(held.ready());
+}
+
+TEST(S21AsyncTest, FreesIntermediates) {
+  CountingResource counting;
+  S21Matrix a = Filled(50, 50, 1), b = Filled(50, 50, 2);
+  S21Matrix c = Filled(50, 50, 3), d = Filled(50, 50, 4);
+  const size_t matrix = Bytes(a);
+  auto f = async::Mul(
+      async::Mul(async::Mul(std::move(a), std::move(b)), std::move(c)),
+      std::move(d));
+  EXPECT_EQ(counting.live, 4 * matrix);
+  counting.peak = counting.live;
+  f.get();
+  // Each product frees its operands once it has run: at most the four
+  // inputs and the first product at once, and only the result at the end.
+  EXPECT_LE(counting.peak, 5 * matrix);
+  EXPECT_EQ(counting.live, matrix);
+}
+
+TEST(S21AsyncTest, Errors) {
+  S21Matrix a = Filled(3, 4, 1), b = Filled(3, 3, 2);
+  EXPECT_THROW(async::Sum(a, b), MatrixException);
+  EXPECT_THROW(async::Sub(a, b), MatrixException);
+  EXPECT_THROW(async::Mul(a, b), MatrixException);
+  EXPECT_THROW(async::Inverse(a), MatrixException);
+  EXPECT_THROW(async::Future<double>{S21Matrix()}, MatrixException);
+  S21Matrix singular(3, 3);
+  auto f = async::Inverse(async::Mul(b, singular));
+  EXPECT_THROW(f.get(), MatrixException);
+  EXPECT_FALSE(f.ready());
+}
+
+TEST(S21AsyncTest, OtherTypes) {
+  using C = std::complex<double>;
+  S21BasicMatrix<C> m(5, 5);
+  for (int i = 0; i < 5; ++i)
+    for (int j = 0; j < 5; ++j) m(i, j) = C(i == j ? 3 : 0, (i + j) % 2);
+  auto f = async::Sum(async::Mul(m, async::Inverse(m)), async::Scale(m, C(0)));
+  S21BasicMatrix<C> identity(5, 5);
+  for (int i = 0; i < 5; ++i) identity(i, i) = 1;
+  EXPECT_TRUE(S21BasicMatrix<C>(f.get()) == identity);
+  S21MatrixF g(4, 4);
+  g(0, 1) = 2;
+  EXPECT_FLOAT_EQ(async::Transpose(async::Scale(g, 0.5f)).get()(1, 0), 1.0f);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_plus/s21_matrix_batch.h"
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Diagonally dominant, so every member of a batch is well conditioned.
+static S21Matrix Member(int rows, int cols, int seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+      m(i, j) = i == j ? rows + 1.0 + seed % 3 : ((i * 3 + j + seed) % 5) - 2;
+  return m;
+}
+
+static S21MatrixBatch Batch(int count, int rows, int cols, int seed) {
+  S21MatrixBatch batch(count, rows, cols);
+  for (int k = 0; k < count; ++k) batch.Set(k, Member(rows, cols, seed + k));
+  return batch;
+}
+
+TEST(S21MatrixBatchTest, Layout) {
+  S21MatrixBatch batch = Batch(11, 2, 3, 0);
+  EXPECT_EQ(batch.get_count(), 11);
+  EXPECT_EQ(batch.get_rows(), 2);
+  EXPECT_EQ(batch.get_cols(), 3);
+  EXPECT_EQ(batch.get_lane_stride(), 16);
+  EXPECT_EQ(batch.lanes(1, 2)[4], Member(2, 3, 4)(1, 2));
+  EXPECT_EQ(batch(4, 1, 2), Member(2, 3, 4)(1, 2));
+  EXPECT_TRUE(batch.Get(7) == Member(2, 3, 7));
+  EXPECT_THROW(batch(11, 0, 0), MatrixException);
+  EXPECT_THROW(batch(0, 2, 0), MatrixException);
+  EXPECT_THROW(batch.Set(0, S21Matrix(3, 2)), MatrixException);
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), MatrixException);
+}
+
+TEST(S21MatrixBatchTest, SumMulTranspose) {
+  S21MatrixBatch a = Batch(9, 3, 4, 1), b = Batch(9, 4, 2, 5);
+  S21MatrixBatch sum = a + Batch(9, 3, 4, 2);
+  S21MatrixBatch product = a * b;
+  S21MatrixBatch transposed = a.Transpose();
+  EXPECT_EQ(product.get_rows(), 3);
+  EXPECT_EQ(product.get_cols(), 2);
+  for (int k = 0; k < 9; ++k) {
+    EXPECT_TRUE(sum.Get(k) == Member(3, 4, 1 + k) + Member(3, 4, 2 + k));
+    EXPECT_TRUE(product.Get(k) == Member(3, 4, 1 + k) * Member(4, 2, 5 + k));
+    EXPECT_TRUE(transposed.Get(k) == Member(3, 4, 1 + k).Transpose());
+  }
+  EXPECT_THROW(a + b, MatrixException);
+  EXPECT_THROW(a * a, MatrixException);
+  EXPECT_THROW(a * Batch(8, 4, 2, 0), MatrixException);
+}
+
+TEST(S21MatrixBatchTest, DeterminantAndInverse) {
+  for (int n = 1; n <= 6; ++n) {
+    S21MatrixBatch batch = Batch(13, n, n, n);
+    std::vector<double> det = batch.Determinant();
+    S21MatrixBatch inverse = batch.InverseMatrix();
+    ASSERT_EQ(det.size(), 13u);
+    for (int k = 0; k < 13; ++k) {
+      S21Matrix member = Member(n, n, n + k);
+      EXPECT_NEAR(det[k], member.Determinant(), 1e-9 * std::abs(det[k]));
+      EXPECT_TRUE(inverse.Get(k) == member.InverseMatrix());
+    }
+  }
+  EXPECT_THROW(Batch(3, 2, 3, 0).Determinant(), MatrixException);
+  EXPECT_THROW(Batch(3, 2, 3, 0).InverseMatrix(), MatrixException);
+}
+
+TEST(S21MatrixBatchTest, SingularMember) {
+  for (int n : {3, 5}) {
+    S21MatrixBatch batch = Batch(4, n, n, 0);
+    for (int j = 0; j < n; ++j) batch(2, 1, j) = batch(2, 0, j);
+    EXPECT_EQ(batch.Determinant()[2], 0.0);
+    EXPECT_NE(batch.Determinant()[1], 0.0);
+    EXPECT_THROW(batch.InverseMatrix(), MatrixException);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+
+#include "../s21_matrix_plus/s21_matrix_counters.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Every test starts from zeroed counters.
+class S21CountersTest : public ::testing::Test {
+ protected:
+  void SetUp() override { S21Counters::Reset(); }
+};
+
+static S21OpStats Find(S21Op op, int shape) {
+  for (const S21OpStats &stats : S21Counters::Snapshot())
+    if (stats.op == op && stats.shape == shape) return stats;
+  return S21OpStats{};
+}
+
+TEST_F(S21CountersTest, ShapeBuckets) {
+  EXPECT_EQ(S21Counters::ShapeBucket(0, 0), 0);
+  EXPECT_EQ(S21Counters::ShapeBucket(1, 1), 0);
+  EXPECT_EQ(S21Counters::ShapeBucket(3, 2), 1);
+  EXPECT_EQ(S21Counters::ShapeBucket(10, 64), 6);
+  EXPECT_EQ(S21Counters::ShapeBucket(1 << 20, 3), 15);
+  EXPECT_EQ(S21Counters::ShapeName(0), "0-1");
+  EXPECT_EQ(S21Counters::ShapeName(6), "64-127");
+  EXPECT_EQ(S21Counters::ShapeName(15), "32768+");
+  EXPECT_STREQ(S21Counters::OpName(S21Op::kMulMatrix), "MulMatrix");
+  EXPECT_STREQ(S21Counters::OpName(S21Op::kLeastSquares), "LeastSquares");
+}
+
+TEST_F(S21CountersTest, NestedProbes) {
+  {
+    S21OpProbe outer(S21Op::kInverseMatrix, 100, 100);
+    outer.AddFlops(1000);
+    S21OpProbe::CountAllocated(64);
+    {
+      S21OpProbe inner(S21Op::kIsCorrect, 100, 100);
+      S21OpProbe::CountCopied(8);
+    }
+    S21OpProbe::CountCopied(16);
+  }
+  S21OpProbe::CountAllocated(32);
+  S21OpStats outer = Find(S21Op::kInverseMatrix, 6);
+  EXPECT_EQ(outer.calls, 1u);
+  EXPECT_EQ(outer.flops, 1000u);
+  EXPECT_EQ(outer.bytes_allocated, 64u);
+  EXPECT_EQ(outer.bytes_copied, 16u);
+  S21OpStats inner = Find(S21Op::kIsCorrect, 6);
+  EXPECT_EQ(inner.calls, 1u);
+  EXPECT_EQ(inner.bytes_copied, 8u);
+  EXPECT_LE(inner.nanoseconds, outer.nanoseconds);
+  uint64_t histogram = 0;
+  for (uint64_t calls : outer.latency) histogram += calls;
+  EXPECT_EQ(histogram, 1u);
+  S21OpStats other = Find(S21Op::kOther, 0);
+  EXPECT_EQ(other.calls, 0u);
+  EXPECT_EQ(other.bytes_allocated, 32u);
+  S21Counters::Reset();
+  EXPECT_TRUE(S21Counters::Snapshot().empty());
+}
+
+TEST_F(S21CountersTest, MergesThreads) {
+  auto record = [] {
+    for (int i = 0; i < 100; ++i) S21OpProbe probe(S21Op::kSumMatrix, 4, 4);
+  };
+  std::vector<std::thread> exited;
+  for (int t = 0; t < 3; ++t) exited.emplace_back(record);
+  for (std::thread &thread : exited) thread.join();
+  // One more thread still alive while the snapshot is taken.
+  std::promise<void> recorded, done;
+  std::thread live([&] {
+    record();
+    recorded.set_value();
+    done.get_future().wait();
+  });
+  recorded.get_future().wait();
+  EXPECT_EQ(Find(S21Op::kSumMatrix, 2).calls, 400u);
+  done.set_value();
+  live.join();
+  EXPECT_EQ(Find(S21Op::kSumMatrix, 2).calls, 400u);
+}
+
+TEST_F(S21CountersTest, Json) {
+  EXPECT_EQ(S21Counters::SnapshotJson(),
+            "{\"hardware_counters\": false, \"operations\": []}");
+  { S21OpProbe probe(S21Op::kDeterminant, 5, 5); }
+  S21OpProbe::CountCopied(24);
+  const std::string json = S21Counters::SnapshotJson();
+  EXPECT_NE(json.find("{\"op\": \"Other\", \"shape\": \"any\", \"calls\": 0"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"bytes_copied\": 24"), std::string::npos);
+  EXPECT_NE(json.find("{\"op\": \"Determinant\", \"shape\": \"4-7\", "
+                      "\"calls\": 1"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"latency\": {\""), std::string::npos);
+  EXPECT_EQ(json.back(), '}');
+}
+
+TEST_F(S21CountersTest, HardwareCounters) {
+  if (!S21Counters::EnableHardwareCounters(true))
+    GTEST_SKIP() << "perf_event_open is not available";
+  EXPECT_TRUE(S21Counters::HardwareCountersEnabled());
+  {
+    S21OpProbe probe(S21Op::kMulNumber, 8, 8);
+    volatile double sum = 0;
+    for (int i = 0; i < 100000; ++i) sum = sum + i;
+  }
+  EXPECT_GT(Find(S21Op::kMulNumber, 3).instructions, 100000u);
+  EXPECT_TRUE(S21Counters::EnableHardwareCounters(false));
+  EXPECT_FALSE(S21Counters::HardwareCountersEnabled());
+}
+
+TEST_F(S21CountersTest, LibraryOperations) {
+  S21Matrix a(40, 30), b(30, 20);
+  S21Counters::Reset();
+  a.MulMatrix(b);
+  S21Matrix c = a;
+  const S21OpStats mul = Find(S21Op::kMulMatrix, 5);
+#ifdef S21_MATRIX_INSTRUMENT
+  EXPECT_EQ(mul.calls, 1u);
+  EXPECT_EQ(mul.flops, 2u * 40 * 30 * 20);
+  EXPECT_GE(Find(S21Op::kIsCorrect, 5).calls, 1u);
+  EXPECT_GE(Find(S21Op::kOther, 0).bytes_copied,
+            40u * 20 * sizeof(double));
+#else
+  // Without S21_MATRIX_INSTRUMENT the library records nothing.
+  EXPECT_EQ(mul.calls, 0u);
+  EXPECT_TRUE(S21Counters::Snapshot().empty());
+#endif
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
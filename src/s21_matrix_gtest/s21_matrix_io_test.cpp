@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_io.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "s21_matrix_test_util.h"
+
+static std::string TempPath(const std::string &name) {
+  return ::testing::TempDir() + "s21_matrix_io_" + name;
+}
+
+TEST(S21MatrixIOTest, SaveAndMap) {
+  std::string path = TempPath("save.bin");
+  S21Matrix m = Filled(5, 11);
+  S21MatrixWriter::Save(m, path);
+  S21MappedMatrix mapped(path);
+  EXPECT_EQ(mapped.get_rows(), 5);
+  EXPECT_EQ(mapped.get_cols(), 11);
+  EXPECT_EQ(mapped.get_stride(), m.get_stride());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped.data()) % 64, 0u);
+  EXPECT_EQ(mapped(4, 10), m(4, 10));
+  EXPECT_THROW(mapped(5, 0), MatrixException);
+  EXPECT_TRUE(mapped.View().EqMatrix(m));
+  S21Matrix copy = mapped.View();
+  EXPECT_TRUE(copy == m);
+  // Views of the mapping are ordinary expression operands.
+  S21Matrix doubled = mapped.View() + m;
+  EXPECT_EQ(doubled(2, 3), 2.0 * m(2, 3));
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixIOTest, StreamingWriter) {
+  std::string path = TempPath("stream.bin");
+  S21Matrix m = Filled(6, 3);
+  {
+    S21MatrixWriter writer(path, 6, 3);
+    writer.WriteRow(m.row(0));
+    writer.WriteRows(m.Block(1, 0, 4, 3));
+    EXPECT_EQ(writer.get_rows_written(), 5);
+    EXPECT_THROW(writer.WriteRows(m.Block(0, 0, 2, 3)), MatrixException);
+    EXPECT_THROW(writer.WriteRows(m.Block(0, 0, 1, 2)), MatrixException);
+    writer.WriteRow(m.row(5));
+    EXPECT_THROW(writer.WriteRow(m.row(0)), MatrixException);
+    writer.Close();
+  }
+  S21MappedMatrix mapped(path);
+  EXPECT_TRUE(mapped.View().EqMatrix(m));
+  S21MappedMatrix moved = std::move(mapped);
+  EXPECT_EQ(moved(5, 2), m(5, 2));
+  EXPECT_EQ(mapped.get_rows(), 0);
+  {
+    S21MatrixWriter short_writer(path, 2, 2);
+    EXPECT_THROW(short_writer.Close(), MatrixException);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixIOTest, RejectsBadFiles) {
+  std::string path = TempPath("bad.bin");
+  EXPECT_THROW(S21MappedMatrix(TempPath("missing.bin")), MatrixException);
+  S21MatrixWriter::Save(Filled(4, 4), path);
+  // Wrong element type.
+  EXPECT_THROW(S21BasicMappedMatrix<float>{path}, MatrixException);
+  // Truncated data.
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size() - 8);
+  }
+  EXPECT_THROW(S21MappedMatrix{path}, MatrixException);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << std::string(128, 'x');
+  }
+  EXPECT_THROW(S21MappedMatrix{path}, MatrixException);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixIOTest, ElementTypes) {
+  std::string path = TempPath("complex.bin");
+  S21MatrixC m(2, 3);
+  m(1, 2) = std::complex<double>(1.5, -2.0);
+  S21BasicMatrixWriter<std::complex<double>>::Save(m, path);
+  S21BasicMappedMatrix<std::complex<double>> mapped(path);
+  EXPECT_EQ(mapped(1, 2), m(1, 2));
+  EXPECT_THROW(S21MappedMatrix{path}, MatrixException);
+  std::remove(path.c_str());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_lu.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Deterministic, well conditioned test matrix: diagonally dominant.
+static S21Matrix Dominant(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) m(i, j) = ((i * 37 + j * 11) % 17) / 17.0;
+    m(i, i) += n;
+  }
+  return m;
+}
+
+TEST(S21LUDecompositionTest, Determinant3x3) {
+  S21Matrix m(3, 3);
+  m(0, 0) = 2;
+  m(0, 1) = 5;
+  m(0, 2) = 7;
+  m(1, 0) = 6;
+  m(1, 1) = 3;
+  m(1, 2) = 4;
+  m(2, 0) = 5;
+  m(2, 1) = -2;
+  m(2, 2) = -3;
+  S21LUDecomposition lu(m);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), -1.0, 1e-12);
+  EXPECT_NEAR(m.Determinant(), -1.0, 1e-12);
+}
+
+TEST(S21LUDecompositionTest, DeterminantOfPermutedTriangular) {
+  // Upper triangular with known diagonal, rows reversed: the pivoting must
+  // restore the order and account for the sign of the permutation.
+  const int n = 150;
+  S21Matrix m(n, n);
+  double expected = 1.0;
+  for (int i = 0; i < n; ++i) {
+    for (int j = i; j < n; ++j) m(n - 1 - i, j) = (i == j) ? 1.0 + i % 3 : 0.5;
+    expected *= 1.0 + i % 3;
+  }
+  // Reversing n rows is n / 2 transpositions.
+  if ((n / 2) % 2) expected = -expected;
+  EXPECT_NEAR(m.Determinant() / expected, 1.0, 1e-9);
+}
+
+TEST(S21LUDecompositionTest, Singular) {
+  S21Matrix m(4, 4);
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j) m(i, j) = i + j;
+  S21LUDecomposition lu(m);
+  EXPECT_NEAR(lu.Determinant(), 0.0, 1e-9);
+  S21Matrix zero(3, 3);
+  S21LUDecomposition lu_zero(zero);
+  EXPECT_TRUE(lu_zero.IsSingular());
+  EXPECT_THROW(lu_zero.Solve(zero), MatrixException);
+}
+
+TEST(S21LUDecompositionTest, SolveMultipleRightHandSides) {
+  const int n = 130;
+  S21Matrix a = Dominant(n);
+  S21Matrix x(n, 3);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < 3; ++j) x(i, j) = (i % 7) - 3.0 + j;
+  S21Matrix b = a * x;
+  S21LUDecomposition lu(a);
+  S21Matrix solved = lu.Solve(b);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(solved.get_element(i, j), x.get_element(i, j), 1e-10);
+}
+
+TEST(S21LUDecompositionTest, Inverse) {
+  const int n = 70;
+  S21Matrix a = Dominant(n);
+  S21Matrix product = a * S21LUDecomposition(a).Inverse();
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      EXPECT_NEAR(product.get_element(i, j), i == j ? 1.0 : 0.0, 1e-12);
+}
+
+TEST(S21LUDecompositionTest, InvalidInput) {
+  S21Matrix rect(2, 3);
+  EXPECT_THROW(S21LUDecomposition lu(rect), MatrixException);
+  S21LUDecomposition lu(Dominant(3));
+  EXPECT_THROW(lu.Solve(rect), MatrixException);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
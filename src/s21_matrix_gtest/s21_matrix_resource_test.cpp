@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_resource.h"
+#include "s21_matrix_test_util.h"
+
+// Upstream that counts what reaches it.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0, live = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    ++live;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    --live;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// The temporaries of a typical request: sums, products, complements.
+static double Compute(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix sum = a + b * 2.0;
+  S21Matrix product = sum * a;
+  product *= b;
+  S21Matrix complements = S21Matrix(a).CalcComplements();
+  return product(0, 0) + complements(1, 1);
+}
+
+TEST(S21MatrixResourceTest, ScopesNest) {
+  std::pmr::memory_resource *initial = S21MatrixResourceScope::Current();
+  EXPECT_EQ(initial, std::pmr::get_default_resource());
+  S21ArenaResource outer_arena, inner_arena;
+  {
+    S21MatrixResourceScope outer(&outer_arena);
+    EXPECT_EQ(S21MatrixResourceScope::Current(), &outer_arena);
+    {
+      S21MatrixResourceScope inner(&inner_arena);
+      EXPECT_EQ(S21MatrixResourceScope::Current(), &inner_arena);
+    }
+    EXPECT_EQ(S21MatrixResourceScope::Current(), &outer_arena);
+  }
+  EXPECT_EQ(S21MatrixResourceScope::Current(), initial);
+}
+
+TEST(S21MatrixResourceTest, MatricesKeepTheirResource) {
+  S21ArenaResource arena;
+  S21Matrix outside = Filled(4, 4, 0, 4);
+  S21Matrix explicit_arena(4, 4, &arena);
+  EXPECT_EQ(explicit_arena.get_resource(), &arena);
+  {
+    S21MatrixResourceScope scope(&arena);
+    S21Matrix a = Filled(4, 4, 0, 4), b = Filled(4, 4, 0, 4);
+    EXPECT_EQ(a.get_resource(), &arena);
+    // Copies take the current resource, assignment keeps the target's.
+    S21Matrix copy = outside;
+    EXPECT_EQ(copy.get_resource(), &arena);
+    outside = a + b;
+    EXPECT_EQ(outside.get_resource(), std::pmr::get_default_resource());
+    outside = std::move(a);
+    EXPECT_EQ(outside.get_resource(), std::pmr::get_default_resource());
+    b *= Filled(4, 4, 0, 4);
+    EXPECT_EQ(b.get_resource(), &arena);
+    EXPECT_TRUE(b == Filled(4, 4, 0, 4) * Filled(4, 4, 0, 4));
+  }
+  EXPECT_TRUE(outside == Filled(4, 4, 0, 4));
+}
+
+TEST(S21MatrixResourceTest, MoveAssignAcrossResources) {
+  S21ArenaResource arena;
+  S21Matrix heap = Filled(40, 40, 0, 40);
+  S21Matrix target(2, 2, &arena);
+  size_t used = arena.get_used_bytes();
+  // Another resource: the elements are copied into the target's arena.
+  target = std::move(heap);
+  EXPECT_EQ(target.get_resource(), &arena);
+  EXPECT_GE(arena.get_used_bytes() - used, 40 * 40 * sizeof(double));
+  EXPECT_TRUE(heap.empty());
+  EXPECT_TRUE(target == Filled(40, 40, 0, 40));
+  // The same resource: the storage itself changes hands.
+  S21Matrix source(40, 40, &arena);
+  const double *storage = std::as_const(source).data();
+  used = arena.get_used_bytes();
+  target = std::move(source);
+  EXPECT_EQ(std::as_const(target).data(), storage);
+  EXPECT_EQ(arena.get_used_bytes(), used);
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(S21MatrixResourceTest, ArenaSettlesToOneChunk) {
+  CountingResource upstream;
+  S21Matrix a = Filled(8, 8, 0, 8), b = Filled(8, 8, 0, 8);
+  double expected = Compute(a, b);
+  {
+    S21ArenaResource arena(1024, &upstream);
+    for (int request = 0; request < 5; ++request) {
+      size_t before = upstream.allocations;
+      {
+        S21MatrixResourceScope scope(&arena);
+        EXPECT_DOUBLE_EQ(Compute(a, b), expected);
+      }
+      EXPECT_GT(arena.get_used_bytes(), 0u);
+      arena.Release();
+      EXPECT_EQ(arena.get_chunk_count(), 1u);
+      EXPECT_EQ(arena.get_used_bytes(), 0u);
+      // After the first request the kept chunk serves everything.
+      if (request > 0) {
+        EXPECT_EQ(upstream.allocations, before);
+      }
+    }
+  }
+  EXPECT_EQ(upstream.live, 0u);
+}
+
+TEST(S21MatrixResourceTest, ArenaAlignment) {
+  S21ArenaResource arena(256);
+  void *small = arena.allocate(3, 1);
+  void *aligned = arena.allocate(100, 64);
+  void *large = arena.allocate(10000, 128);
+  EXPECT_NE(small, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % 128, 0u);
+  EXPECT_EQ(arena.get_used_bytes(), 10103u);
+}
+
+TEST(S21MatrixResourceTest, PoolRecyclesBlocks) {
+  CountingResource upstream;
+  S21Matrix a = Filled(8, 8, 0, 8), b = Filled(8, 8, 0, 8);
+  double expected = Compute(a, b);
+  {
+    S21PoolResource pool(size_t(1) << 16, &upstream);
+    S21MatrixResourceScope scope(&pool);
+    EXPECT_DOUBLE_EQ(Compute(a, b), expected);
+    size_t warm = upstream.allocations;
+    for (int i = 0; i < 10; ++i) EXPECT_DOUBLE_EQ(Compute(a, b), expected);
+    EXPECT_EQ(upstream.allocations, warm);
+    EXPECT_GT(pool.get_cached_bytes(), 0u);
+    // Past max_block the pool is bypassed.
+    void *big = pool.allocate(size_t(1) << 17, 64);
+    EXPECT_EQ(upstream.allocations, warm + 1);
+    pool.deallocate(big, size_t(1) << 17, 64);
+  }
+  EXPECT_EQ(upstream.live, 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
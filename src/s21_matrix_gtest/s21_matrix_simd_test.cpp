@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_simd.h"
+
+static const s21::SimdLevel kLevels[] = {
+    s21::SimdLevel::kScalar, s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+    s21::SimdLevel::kAvx512};
+// Lengths around every vector width, started off alignment.
+static const size_t kSizes[] = {0, 1, 3, 7, 8, 9, 15, 63, 64, 65, 200};
+
+static std::vector<double> Values(size_t n, double seed) {
+  std::vector<double> v(n + 1);
+  for (size_t k = 0; k < v.size(); ++k) v[k] = seed + (k * 7 % 11) * 0.5;
+  return v;
+}
+
+TEST(S21SimdTest, SelectedLevelIsSupported) {
+  EXPECT_LE(s21::Simd().level, s21::DetectSimdLevel());
+  EXPECT_EQ(s21::SimdKernelsFor(s21::SimdLevel::kAvx512).level,
+            s21::DetectSimdLevel());
+}
+
+TEST(S21SimdTest, ArithmeticKernels) {
+  for (s21::SimdLevel level : kLevels) {
+    const s21::SimdKernels<double> &k = s21::SimdKernelsFor(level);
+    for (size_t n : kSizes) {
+      std::vector<double> a = Values(n, 1.0), b = Values(n, -2.0);
+      std::vector<double> add(a), sub(a), scale(a), axpy(a);
+      k.add(add.data() + 1, b.data() + 1, n);
+      k.sub(sub.data() + 1, b.data() + 1, n);
+      k.scale(scale.data() + 1, 3.0, n);
+      k.axpy(axpy.data() + 1, -0.5, b.data() + 1, n);
+      for (size_t i = 1; i <= n; ++i) {
+        EXPECT_EQ(add[i], a[i] + b[i]) << k.name << " n=" << n;
+        EXPECT_EQ(sub[i], a[i] - b[i]) << k.name << " n=" << n;
+        EXPECT_EQ(scale[i], a[i] * 3.0) << k.name << " n=" << n;
+        EXPECT_NEAR(axpy[i], a[i] - 0.5 * b[i], 1e-15) << k.name;
+      }
+      // The element in front of the range must be left alone.
+      EXPECT_EQ(add[0], a[0]);
+      EXPECT_EQ(axpy[0], a[0]);
+    }
+  }
+}
+
+TEST(S21SimdTest, EqualKernel) {
+  for (s21::SimdLevel level : kLevels) {
+    const s21::SimdKernels<double> &k = s21::SimdKernelsFor(level);
+    for (size_t n : kSizes) {
+      std::vector<double> a = Values(n, 1.0), b(a);
+      for (double &x : b) x += 1e-9;
+      EXPECT_TRUE(k.equal(a.data() + 1, b.data() + 1, n, 1e-7)) << k.name;
+      if (n == 0) continue;
+      b[n] += 1e-3;
+      EXPECT_FALSE(k.equal(a.data() + 1, b.data() + 1, n, 1e-7))
+          << k.name << " n=" << n;
+      b[n] = std::numeric_limits<double>::quiet_NaN();
+      EXPECT_TRUE(k.equal(a.data() + 1, b.data() + 1, n, 1e-7)) << k.name;
+    }
+  }
+}
+
+TEST(S21SimdTest, FloatKernels) {
+  for (s21::SimdLevel level : kLevels) {
+    const s21::SimdKernels<float> &k = s21::SimdKernelsFor<float>(level);
+    EXPECT_EQ(k.level, s21::SimdKernelsFor<double>(level).level);
+    for (size_t n : kSizes) {
+      std::vector<float> a(n + 1), b(n + 1);
+      for (size_t i = 0; i <= n; ++i) {
+        a[i] = 1.0f + (i * 7 % 11) * 0.5f;
+        b[i] = -2.0f + (i * 5 % 3) * 0.25f;
+      }
+      std::vector<float> add(a), scale(a), axpy(a), near(a);
+      k.add(add.data() + 1, b.data() + 1, n);
+      k.scale(scale.data() + 1, 3.0f, n);
+      k.axpy(axpy.data() + 1, -0.5f, b.data() + 1, n);
+      for (size_t i = 1; i <= n; ++i) {
+        EXPECT_EQ(add[i], a[i] + b[i]) << k.name << " n=" << n;
+        EXPECT_EQ(scale[i], a[i] * 3.0f) << k.name << " n=" << n;
+        EXPECT_NEAR(axpy[i], a[i] - 0.5f * b[i], 1e-6f) << k.name;
+        near[i] += 1e-6f;
+      }
+      EXPECT_EQ(add[0], a[0]);
+      EXPECT_TRUE(k.equal(a.data() + 1, near.data() + 1, n, 1e-5f));
+      if (n == 0) continue;
+      near[n] += 1e-3f;
+      EXPECT_FALSE(k.equal(a.data() + 1, near.data() + 1, n, 1e-5f))
+          << k.name << " n=" << n;
+    }
+  }
+}
+
+TEST(S21SimdTest, ScalarOnlyTypes) {
+  EXPECT_EQ(s21::Simd<long double>().level, s21::SimdLevel::kScalar);
+  EXPECT_EQ(s21::Simd<std::complex<double>>().level, s21::SimdLevel::kScalar);
+}
+
+TEST(S21SimdTest, MatrixAxpy) {
+  S21Matrix a(3, 5), b(3, 5);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 5; ++j) {
+      a(i, j) = i + j;
+      b(i, j) = i - j;
+    }
+  a.Axpy(2.0, b);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 5; ++j) EXPECT_EQ(a(i, j), i + j + 2.0 * (i - j));
+  EXPECT_THROW(a.Axpy(1.0, S21Matrix(5, 3)), MatrixException);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_solve.h"
+#include "../s21_matrix_plus/s21_thread_pool.h"
+
+// Deterministic, well conditioned, not symmetric.
+static S21Matrix General(int rows, int cols) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+      m(i, j) = ((i * 37 + j * 11) % 17) / 17.0 + (i == j ? cols : 0);
+  return m;
+}
+
+// B^T * B + n * I, symmetric positive definite.
+static S21Matrix Spd(int n) {
+  S21Matrix b = General(n, n);
+  S21Matrix a = b.Transpose() * b;
+  for (int i = 0; i < n; ++i) a(i, i) += n;
+  return a;
+}
+
+static S21Matrix Rhs(int rows, int cols) {
+  S21Matrix x(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j) x(i, j) = (i % 7) - 3.0 + j;
+  return x;
+}
+
+static void ExpectNear(const S21Matrix &a, const S21Matrix &b, double eps) {
+  ASSERT_EQ(a.get_rows(), b.get_rows());
+  ASSERT_EQ(a.get_cols(), b.get_cols());
+  for (int i = 0; i < a.get_rows(); ++i)
+    for (int j = 0; j < a.get_cols(); ++j) EXPECT_NEAR(a(i, j), b(i, j), eps);
+}
+
+TEST(S21SolveTest, GeneralSystem) {
+  const int n = 90;
+  S21Matrix a = General(n, n), x = Rhs(n, 4);
+  S21LinearSolver solver(a);
+  EXPECT_EQ(solver.get_method(), S21SolveMethod::kLu);
+  ExpectNear(solver.Solve(a * x), x, 1e-10);
+  ExpectNear(a.Solve(a * x), x, 1e-10);
+  S21Matrix y = Rhs(n, 1) * 2.0;
+  ExpectNear(solver.Solve(a * y), y, 1e-10);
+}
+
+TEST(S21SolveTest, CholeskyPath) {
+  const int n = 80;
+  S21Matrix a = Spd(n), x = Rhs(n, 3);
+  S21CholeskyDecomposition cholesky(a);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  S21Matrix l = cholesky.get_l();
+  EXPECT_EQ(l(0, 1), 0.0);
+  ExpectNear(l * l.Transpose(), a, 1e-9);
+  EXPECT_TRUE(S21LinearSolver::LooksPositiveDefinite(a));
+  S21LinearSolver solver(a);
+  EXPECT_EQ(solver.get_method(), S21SolveMethod::kCholesky);
+  ExpectNear(solver.Solve(a * x), x, 1e-10);
+  ExpectNear(a.Solve(a * x, S21SolveHint::kPositiveDefinite), x, 1e-10);
+  EXPECT_EQ(S21LinearSolver(a, S21SolveHint::kGeneral).get_method(),
+            S21SolveMethod::kLu);
+}
+
+// Right-hand side columns are split between the workers, which share the
+// solution matrix; build with make SANITIZE=thread to check them.
+TEST(S21SolveTest, ParallelRightHandSides) {
+  const int n = 64;
+  S21Matrix a = General(n, n), spd = Spd(n), tall = General(n + 20, n);
+  S21Matrix x = Rhs(n, 256);
+  S21ThreadPool pool(4);
+  pool.set_serial_threshold(0);
+  S21ThreadPoolScope scope(pool);
+  ExpectNear(a.Solve(a * x), x, 1e-10);
+  ExpectNear(spd.Solve(spd * x, S21SolveHint::kPositiveDefinite), x, 1e-10);
+  ExpectNear(tall.LeastSquares(tall * x), x, 1e-10);
+}
+
+TEST(S21SolveTest, IndefiniteFallsBackToLu) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 1;
+  a(0, 1) = a(1, 0) = 3;
+  a(1, 1) = 1;
+  a(2, 2) = 2;
+  EXPECT_TRUE(S21LinearSolver::LooksPositiveDefinite(a));
+  EXPECT_FALSE(S21CholeskyDecomposition(a).IsPositiveDefinite());
+  S21LinearSolver solver(a);
+  EXPECT_EQ(solver.get_method(), S21SolveMethod::kLu);
+  S21Matrix x = Rhs(3, 2);
+  ExpectNear(solver.Solve(a * x), x, 1e-12);
+  EXPECT_THROW(S21LinearSolver(a, S21SolveHint::kPositiveDefinite),
+               MatrixException);
+  EXPECT_THROW(S21CholeskyDecomposition(a).Solve(x), MatrixException);
+}
+
+TEST(S21SolveTest, LeastSquares) {
+  // Overdetermined but consistent: the exact solution is recovered.
+  S21Matrix a = General(120, 40), x = Rhs(40, 2);
+  ExpectNear(a.LeastSquares(a * x), x, 1e-10);
+  // Line fit through points off a line: residual orthogonal to columns.
+  S21Matrix fit(5, 2), y(5, 1);
+  for (int i = 0; i < 5; ++i) {
+    fit(i, 0) = 1;
+    fit(i, 1) = i;
+    y(i, 0) = 2.0 * i + 1 + (i % 2 ? 0.5 : -0.5);
+  }
+  S21QRDecomposition qr(fit);
+  EXPECT_FALSE(qr.IsRankDeficient());
+  S21Matrix coef = qr.Solve(y);
+  S21Matrix residual = fit * coef - y;
+  ExpectNear(fit.Transpose() * residual, S21Matrix(2, 1), 1e-12);
+  // |R| has the column norms of an orthogonal basis.
+  S21Matrix r = qr.R();
+  EXPECT_NEAR(std::abs(r(0, 0)), std::sqrt(5.0), 1e-12);
+  EXPECT_EQ(r(1, 0), 0.0);
+}
+
+TEST(S21SolveTest, ComplexSystems) {
+  using C = std::complex<double>;
+  const int n = 6;
+  S21BasicMatrix<C> b(n, n), x(n, 2);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) b(i, j) = C((i + 2 * j) % 5, (i * j) % 3);
+    x(i, 0) = C(i, 1);
+    x(i, 1) = C(-1, i);
+  }
+  // B^H * B + n * I is Hermitian positive definite.
+  S21BasicMatrix<C> bh(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) bh(i, j) = std::conj(b(j, i));
+  S21BasicMatrix<C> a = bh * b;
+  for (int i = 0; i < n; ++i) a(i, i) += C(n);
+  S21BasicLinearSolver<C> solver(a);
+  EXPECT_EQ(solver.get_method(), S21SolveMethod::kCholesky);
+  S21BasicMatrix<C> solved = solver.Solve(a * x);
+  S21BasicMatrix<C> fitted = b.LeastSquares(b * x);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      EXPECT_NEAR(std::abs(solved(i, j) - x(i, j)), 0.0, 1e-10);
+      EXPECT_NEAR(std::abs(fitted(i, j) - x(i, j)), 0.0, 1e-10);
+    }
+  }
+}
+
+TEST(S21SolveTest, InvalidInput) {
+  S21Matrix rect = General(2, 3), square = General(3, 3);
+  EXPECT_THROW(rect.Solve(Rhs(2, 1)), MatrixException);
+  EXPECT_THROW(square.Solve(Rhs(2, 1)), MatrixException);
+  EXPECT_THROW(rect.LeastSquares(Rhs(2, 1)), MatrixException);
+  EXPECT_THROW(General(4, 3).LeastSquares(Rhs(3, 1)), MatrixException);
+  EXPECT_THROW(S21CholeskyDecomposition{rect}, MatrixException);
+  S21Matrix dependent(4, 2);
+  for (int i = 0; i < 4; ++i) dependent(i, 0) = dependent(i, 1) = i + 1;
+  S21QRDecomposition qr(dependent);
+  EXPECT_TRUE(qr.IsRankDeficient());
+  EXPECT_THROW(qr.Solve(Rhs(4, 1)), MatrixException);
+  S21Matrix singular(2, 2);
+  EXPECT_THROW(singular.Solve(Rhs(2, 1)), MatrixException);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
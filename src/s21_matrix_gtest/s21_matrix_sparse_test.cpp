@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_sparse.h"
+#include "../s21_matrix_plus/s21_thread_pool.h"
+
+// Deterministic matrix with roughly one nonzero in three elements.
+static S21Matrix Scattered(int rows, int cols, int seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+      if ((i * 7 + j * 5 + seed) % 3 == 0) m(i, j) = i - j + 0.5 * seed;
+  return m;
+}
+
+TEST(S21SparseMatrixTest, DenseRoundTrip) {
+  S21Matrix dense = Scattered(5, 7, 1);
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense, format);
+    EXPECT_EQ(sparse.get_format(), format);
+    EXPECT_EQ(sparse.get_rows(), 5);
+    EXPECT_EQ(sparse.get_cols(), 7);
+    EXPECT_LT(sparse.NonZeros(), 35u);
+    EXPECT_TRUE(sparse.ToDense() == dense);
+    for (int i = 0; i < 5; ++i)
+      for (int j = 0; j < 7; ++j) EXPECT_EQ(sparse(i, j), dense(i, j));
+  }
+  EXPECT_THROW(S21SparseMatrix(dense)(5, 0), MatrixException);
+  EXPECT_THROW(S21SparseMatrix(0, 3), MatrixException);
+}
+
+TEST(S21SparseMatrixTest, BuilderSumsDuplicates) {
+  S21SparseBuilder builder(3, 4);
+  builder.Add(2, 3, 1.0);
+  builder.Add(0, 1, 2.0);
+  builder.Add(2, 3, 4.0);
+  builder.Add(1, 0, -1.0);
+  builder.Add(0, 0, 3.0);
+  EXPECT_EQ(builder.size(), 5u);
+  EXPECT_THROW(builder.Add(3, 0, 1.0), MatrixException);
+  S21SparseMatrix csr = builder.Build();
+  S21SparseMatrix csc = builder.Build(S21SparseFormat::kCsc);
+  EXPECT_EQ(csr.NonZeros(), 4u);
+  EXPECT_EQ(csr(2, 3), 5.0);
+  EXPECT_EQ(csr(0, 1), 2.0);
+  EXPECT_EQ(csr(1, 1), 0.0);
+  EXPECT_EQ(csr.get_ptr(), (std::vector<size_t>{0, 2, 3, 4}));
+  EXPECT_EQ(csr.get_index(), (std::vector<int>{0, 1, 0, 3}));
+  EXPECT_EQ(csc.get_ptr(), (std::vector<size_t>{0, 2, 3, 3, 4}));
+  EXPECT_EQ(csc.get_index(), (std::vector<int>{0, 1, 0, 2}));
+  EXPECT_TRUE(csr.ToDense() == csc.ToDense());
+  EXPECT_EQ(csr.ToFormat(S21SparseFormat::kCsc).get_values(),
+            csc.get_values());
+}
+
+TEST(S21SparseMatrixTest, Transpose) {
+  S21Matrix dense = Scattered(4, 6, 2);
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix transposed = S21SparseMatrix(dense, format).Transpose();
+    EXPECT_EQ(transposed.get_format(), format);
+    EXPECT_TRUE(transposed.ToDense() == dense.Transpose());
+  }
+}
+
+TEST(S21SparseMatrixTest, MulVectorAndMatrix) {
+  S21Matrix a = Scattered(6, 5, 0), b = Scattered(5, 3, 1);
+  b(0, 0) = 1.0;
+  std::vector<double> x = {1.0, -2.0, 0.5, 3.0, 0.0};
+  S21Matrix expected = a * b;
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(a, format);
+    EXPECT_TRUE((sparse * b) == expected);
+    std::vector<double> y = sparse * x;
+    ASSERT_EQ(y.size(), 6u);
+    for (int i = 0; i < 6; ++i) {
+      double sum = 0.0;
+      for (int j = 0; j < 5; ++j) sum += a(i, j) * x[j];
+      EXPECT_DOUBLE_EQ(y[i], sum);
+    }
+    EXPECT_THROW(sparse * a, MatrixException);
+    EXPECT_THROW(sparse * std::vector<double>(6), MatrixException);
+  }
+}
+
+// Rows of the product are split between the workers; build with
+// make SANITIZE=thread to check that they only share what they read.
+TEST(S21SparseMatrixTest, ParallelMulMatrix) {
+  S21Matrix a = Scattered(200, 150, 2), b = Scattered(150, 60, 3);
+  S21Matrix expected = a * b;
+  S21ThreadPool pool(4);
+  pool.set_serial_threshold(0);
+  S21ThreadPoolScope scope(pool);
+  EXPECT_TRUE((S21SparseMatrix(a) * b) == expected);
+}
+
+TEST(S21SparseMatrixTest, SumMatrix) {
+  S21Matrix a = Scattered(5, 5, 0), b = Scattered(5, 5, 1);
+  S21SparseMatrix csr(a), csc(b, S21SparseFormat::kCsc);
+  S21SparseMatrix sum = csr + csc;
+  EXPECT_EQ(sum.get_format(), S21SparseFormat::kCsr);
+  S21Matrix expected = a + b;
+  EXPECT_TRUE(sum.ToDense() == expected);
+  EXPECT_TRUE((csc + csr).ToDense() == expected);
+  EXPECT_LE(sum.NonZeros(), csr.NonZeros() + csc.NonZeros());
+  EXPECT_THROW(csr + S21SparseMatrix(4, 5), MatrixException);
+}
+
+TEST(S21SparseMatrixTest, ElementTypes) {
+  S21BasicSparseBuilder<float> builder(2, 2);
+  builder.Add(0, 1, 2.0f);
+  builder.Add(1, 0, 3.0f);
+  S21MatrixF b(2, 1);
+  b(0, 0) = 1.0f;
+  b(1, 0) = 4.0f;
+  S21MatrixF product = builder.Build() * b;
+  EXPECT_EQ(product(0, 0), 8.0f);
+  EXPECT_EQ(product(1, 0), 3.0f);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
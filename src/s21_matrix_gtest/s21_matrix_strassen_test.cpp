@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_strassen.h"
+#include "s21_matrix_test_util.h"
+
+// Small crossover so that modest sizes recurse several levels; restores
+// the default when the test ends.
+class S21StrassenTest : public ::testing::Test {
+ protected:
+  void SetUp() override { s21::SetStrassenCrossover(8); }
+  void TearDown() override {
+    s21::SetStrassenCrossover(s21::kStrassenCrossover);
+  }
+};
+
+static S21Matrix Product(const S21Matrix &a, const S21Matrix &b,
+                         S21MulAlgorithm algorithm) {
+  S21Matrix c = a;
+  c.MulMatrix(b, algorithm);
+  return c;
+}
+
+static double MaxDifference(const S21Matrix &a, const S21Matrix &b) {
+  double result = 0;
+  for (int i = 0; i < a.get_rows(); ++i)
+    for (int j = 0; j < a.get_cols(); ++j)
+      result = std::max(result, std::abs(a(i, j) - b(i, j)));
+  return result;
+}
+
+TEST_F(S21StrassenTest, MatchesClassicalOnOddShapes) {
+  const int shapes[][3] = {{64, 64, 64}, {67, 45, 51}, {33, 100, 17},
+                           {9, 9, 9},    {128, 31, 77}};
+  for (const auto &s : shapes) {
+    S21Matrix a = Filled(s[0], s[2], 1), b = Filled(s[2], s[1], 2);
+    S21Matrix fast = Product(a, b, S21MulAlgorithm::kStrassen);
+    S21Matrix classical = Product(a, b, S21MulAlgorithm::kClassical);
+    ASSERT_EQ(fast.get_rows(), s[0]);
+    ASSERT_EQ(fast.get_cols(), s[1]);
+    EXPECT_LT(MaxDifference(fast, classical), 1e-12);
+  }
+}
+
+TEST_F(S21StrassenTest, ParallelTopLevel) {
+  S21ThreadPool pool(4);
+  pool.set_serial_threshold(0);
+  S21ThreadPoolScope scope(pool);
+  S21Matrix a = Filled(97, 90, 3), b = Filled(90, 83, 4);
+  EXPECT_LT(MaxDifference(Product(a, b, S21MulAlgorithm::kStrassen),
+                          Product(a, b, S21MulAlgorithm::kClassical)),
+            1e-12);
+}
+
+TEST_F(S21StrassenTest, WithinErrorBound) {
+  // n = 2^4 * n0: the bound of s21_matrix_strassen.h with max|A| and max|B|
+  // at most 1/2, against an exact integer product.
+  const int n = 128, n0 = 8;
+  S21Matrix a(n, n), b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = ((i * 13 + j * 7) % 17) / 32.0 - 0.25;
+      b(i, j) = ((i * 5 + j * 11) % 19) / 32.0 - 0.25;
+    }
+  }
+  S21Matrix exact = Product(a, b, S21MulAlgorithm::kClassical);
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+  const double bound =
+      (std::pow(double(n) / n0, std::log2(18.0)) * (n0 * n0 + 6 * n0) -
+       6 * n) *
+      u * 0.25 * 0.25;
+  EXPECT_LE(MaxDifference(Product(a, b, S21MulAlgorithm::kStrassen), exact),
+            bound);
+}
+
+TEST_F(S21StrassenTest, ComplexAndFloat) {
+  using C = std::complex<double>;
+  S21BasicMatrix<C> a(40, 36), b(36, 44);
+  for (int i = 0; i < 40; ++i)
+    for (int j = 0; j < 36; ++j) a(i, j) = C((i + j) % 5, (i * j) % 3);
+  for (int i = 0; i < 36; ++i)
+    for (int j = 0; j < 44; ++j) b(i, j) = C((2 * i + j) % 7, -(i % 2));
+  S21BasicMatrix<C> fast = a, classical = a;
+  fast.MulMatrix(b, S21MulAlgorithm::kStrassen);
+  classical.MulMatrix(b, S21MulAlgorithm::kClassical);
+  EXPECT_TRUE(fast == classical);
+  S21MatrixF f(50, 50);
+  for (int i = 0; i < 50; ++i)
+    for (int j = 0; j < 50; ++j) f(i, j) = (i + 2 * j) % 9 - 4;
+  S21MatrixF g = f;
+  g.MulMatrix(f, S21MulAlgorithm::kStrassen);
+  EXPECT_TRUE(g == f * f);
+}
+
+TEST_F(S21StrassenTest, AutoHeuristic) {
+  EXPECT_EQ(s21::GetStrassenCrossover(), 8);
+  EXPECT_TRUE(s21::PreferStrassen(32, 32, 32));
+  EXPECT_FALSE(s21::PreferStrassen(32, 31, 32));
+  s21::SetStrassenCrossover(0);
+  EXPECT_EQ(s21::GetStrassenCrossover(), 1);
+  s21::SetStrassenCrossover(s21::kStrassenCrossover);
+  EXPECT_FALSE(s21::PreferStrassen(512, 512, 512));
+  EXPECT_TRUE(s21::PreferStrassen(1024, 2048, 1024));
+  // operator* and MulMatrix default to kAuto.
+  s21::SetStrassenCrossover(4);
+  S21Matrix a = Filled(20, 20, 5), b = Filled(20, 20, 6);
+  EXPECT_LT(MaxDifference(a * b, Product(a, b, S21MulAlgorithm::kClassical)),
+            1e-12);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
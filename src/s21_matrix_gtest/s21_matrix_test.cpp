@@ -1,8 +1,41 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
 #include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_fixed.h"
 #include "../s21_matrix_plus/s21_matrix_oop.h"
 
+// Every heap allocation of this test binary goes through these, so tests
+// can count how many allocations a piece of code makes.
+static std::atomic<size_t> allocations(0);
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  ++allocations;
+  void *p = nullptr;
+  if (posix_memalign(&p, static_cast<std::size_t>(align), size ? size : 1))
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
 // constructors
 TEST(S21MatrixTest, DefaultConstructor) {
   S21Matrix m;
@@ -46,6 +79,85 @@ TEST(S21MatrixTest, MoveConstructor) {
   EXPECT_EQ(m1.get_cols(), 0);
 }
 
+TEST(S21MatrixTest, CopyAndMoveEmpty) {
+  S21Matrix empty;
+  S21Matrix copy(empty);
+  EXPECT_TRUE(copy.empty());
+  S21Matrix moved(std::move(copy));
+  EXPECT_TRUE(moved.empty());
+  S21Matrix m(2, 2);
+  m = empty;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.get_rows(), 0);
+}
+
+// Containers of matrices move their elements when they grow. Move
+// assignment copies between memory resources, so it may throw.
+TEST(S21MatrixTest, NoexceptMoves) {
+  static_assert(std::is_nothrow_move_constructible<S21Matrix>::value);
+  static_assert(!std::is_nothrow_move_assignable<S21Matrix>::value);
+}
+
+// A vector of matrices grows by moving its elements, so every push_back of
+// a copy costs the copy itself plus the occasional vector reallocation.
+TEST(S21MatrixTest, PushBackAllocations) {
+  S21Matrix m(16, 16);
+  std::vector<S21Matrix> v;
+  size_t regrowths = 0;
+  size_t before = allocations;
+  for (int i = 0; i < 100; ++i) {
+    size_t capacity = v.capacity();
+    v.push_back(m);
+    regrowths += v.capacity() != capacity;
+  }
+  EXPECT_EQ(allocations - before, 100 + regrowths);
+}
+
+TEST(S21MatrixTest, AssignmentReusesStorage) {
+  S21Matrix a(32, 32), b(32, 32);
+  b(3, 4) = 2.0;
+  const double *storage = a.data();
+  size_t before = allocations;
+  a = b;
+  EXPECT_EQ(allocations, before);
+  EXPECT_EQ(a.data(), storage);
+  EXPECT_EQ(a(3, 4), 2.0);
+}
+
+TEST(S21MatrixTest, RepeatedMulAssignAllocations) {
+  S21Matrix a(64, 64), b(64, 64), c(64, 64);
+  for (int i = 0; i < 64; ++i) {
+    a(i, i) = 1.0;
+    b(i, (i + 1) % 64) = 1.0;
+    c(i, (i + 10) % 64) = 1.0;
+  }
+  a *= b;  // warms up the product and packing buffers
+  size_t before = allocations;
+  for (int k = 1; k < 10; ++k) a *= b;
+  EXPECT_EQ(allocations, before);
+  EXPECT_TRUE(a == c);
+}
+
+TEST(S21MatrixTest, MulAssignReshapes) {
+  S21Matrix a(2, 3), b(3, 9);
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j) a(i, j) = i + j;
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 9; ++j) b(i, j) = i * j;
+  S21Matrix expected = a * b;
+  a *= b;
+  EXPECT_EQ(a.get_cols(), 9);
+  EXPECT_TRUE(a == expected);
+  a *= S21Matrix(9, 1);
+  EXPECT_EQ(a.get_cols(), 1);
+  EXPECT_EQ(a(1, 0), 0.0);
+  S21Matrix self(3, 3);
+  self(0, 1) = self(1, 2) = 1.0;
+  self *= self;
+  EXPECT_EQ(self(0, 2), 1.0);
+  EXPECT_EQ(self(0, 1), 0.0);
+}
+
 // accessors & mutators
 TEST(S21MatrixTest, GetSetRows) {
   S21Matrix m(3, 4);
@@ -63,6 +175,21 @@ TEST(S21MatrixTest, GetSetCols) {
   EXPECT_THROW(m.set_cols(-6), MatrixException);
 }
 
+TEST(S21MatrixTest, SetColsKeepsElements) {
+  S21Matrix m(2, 10);
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 10; ++j) m.set_element(i, j, i * 10 + j);
+  m.set_cols(3);
+  m.set_cols(12);
+  EXPECT_EQ(m.get_element(1, 2), 12.0);
+  EXPECT_EQ(m.get_element(1, 3), 0.0);
+  EXPECT_EQ(m.get_element(0, 11), 0.0);
+  m.set_cols(2);
+  m.set_rows(3);
+  EXPECT_EQ(m.get_element(1, 1), 11.0);
+  EXPECT_EQ(m.get_element(2, 1), 0.0);
+}
+
 // set_element & get_element
 TEST(S21MatrixTest, SetElement) {
   S21Matrix m(3, 3);
@@ -149,6 +276,41 @@ TEST(S21MatrixTest, OperatorMultiplyNumber) {
   EXPECT_EQ(result.get_element(0, 1), 4.0);
 }
 
+// fused elementwise expressions
+TEST(S21MatrixTest, ExpressionChain) {
+  S21Matrix a(2, 3), b(2, 3), c(2, 3);
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j) {
+      a(i, j) = i + j;
+      b(i, j) = i * j;
+      c(i, j) = 1.0;
+    }
+  S21Matrix r = a + b * 2.0 - 0.5 * c;
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_EQ(r.get_element(i, j), i + j + 2.0 * i * j - 0.5);
+  r = r - a;
+  r += b - c;
+  EXPECT_EQ(r.get_element(1, 2), 2.0 * 2 - 0.5 + 2 - 1);
+  a = a + a;
+  EXPECT_EQ(a.get_element(1, 2), 6.0);
+  S21Matrix empty;
+  empty = a - b;
+  EXPECT_EQ(empty.get_element(1, 2), 4.0);
+}
+// expressions with a temporary left operand are evaluated in place
+TEST(S21MatrixTest, ExpressionTemporary) {
+  S21Matrix a(2, 2), b(2, 2);
+  a(0, 0) = 1.0;
+  a(1, 1) = 2.0;
+  b(0, 1) = 3.0;
+  S21Matrix r = a * a * 2.0 + b;
+  EXPECT_EQ(r.get_element(0, 0), 2.0);
+  EXPECT_EQ(r.get_element(0, 1), 3.0);
+  EXPECT_EQ(r.get_element(1, 1), 8.0);
+  EXPECT_THROW(S21Matrix(a * a) - S21Matrix(3, 3), MatrixException);
+  EXPECT_THROW(a + b * 2.0 - S21Matrix(2, 3), MatrixException);
+}
 // * for matrix
 TEST(S21MatrixTest, OperatorMultiplyMatrix) {
   S21Matrix m1(2, 3);
@@ -176,6 +338,27 @@ TEST(S21MatrixTest, InvalidDimensionMultiplyMatrix) {
   S21Matrix m2(1, 1);
   EXPECT_THROW(m1.MulMatrix(m2), MatrixException);
 }
+// * crossing the GEMM cache blocks and register tile edges
+TEST(S21MatrixTest, MulMatrixBlocked) {
+  const int m = 101, k = 263, n = 37;
+  S21Matrix a(m, k);
+  S21Matrix b(k, n);
+  for (int i = 0; i < m; ++i)
+    for (int j = 0; j < k; ++j) a(i, j) = (i * 7 + j * 3) % 11 - 5;
+  for (int i = 0; i < k; ++i)
+    for (int j = 0; j < n; ++j) b(i, j) = (i * 5 + j * 13) % 9 - 4;
+  S21Matrix c = a * b;
+  a.MulMatrix(b);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double expected = 0.0;
+      for (int p = 0; p < k; ++p)
+        expected += ((i * 7 + p * 3) % 11 - 5) * ((p * 5 + j * 13) % 9 - 4);
+      EXPECT_EQ(c.get_element(i, j), expected);
+      EXPECT_EQ(a.get_element(i, j), expected);
+    }
+  }
+}
 // == 1
 TEST(S21MatrixTest, OperatorEqual1) {
   S21Matrix m1(2, 2);
@@ -267,9 +450,27 @@ TEST(S21MatrixTest, OperatorParentheses) {
   EXPECT_EQ(m1(0, 0), 3.0);
 }
 // () exception
+#ifndef S21_MATRIX_UNCHECKED
 TEST(S21MatrixTest, InvalidOperatorParentheses) {
   S21Matrix m1(2, 2);
   EXPECT_THROW(m1(-3, 4), MatrixException);
+  const S21Matrix m2(2, 2);
+  EXPECT_THROW(m2(0, 2), MatrixException);
+  EXPECT_THROW(m1.row(2), MatrixException);
+}
+#endif
+// explicit access policies and raw row access
+TEST(S21MatrixTest, AccessPolicies) {
+  S21Matrix m(3, 3);
+  m.at<S21UncheckedAccess>(1, 2) = 5.0;
+  EXPECT_EQ(m.at<S21CheckedAccess>(1, 2), 5.0);
+  EXPECT_THROW(m.at<S21CheckedAccess>(3, 0), MatrixException);
+  m.row(2)[1] = 7.0;
+  const S21Matrix &c = m;
+  EXPECT_EQ(c(2, 1), 7.0);
+  EXPECT_EQ(c.row<S21UncheckedAccess>(1)[2], 5.0);
+  EXPECT_GE(m.get_stride(), m.get_cols());
+  EXPECT_EQ(c.data()[2 * m.get_stride() + 1], 7.0);
 }
 // iscorrect exception
 TEST(S21MatrixTest, IsCorrectEmptyMatrix) {
@@ -366,11 +567,472 @@ TEST(S21MatrixTest, Inverse) {
   EXPECT_NEAR(result.get_element(1, 0), -0.2, 1e-9);
   EXPECT_NEAR(result.get_element(1, 1), 0.4, 1e-9);
 }
+// CalcComplements
+TEST(S21MatrixTest, CalcComplements) {
+  S21Matrix m(3, 3);
+  m(0, 0) = 1;
+  m(0, 1) = 2;
+  m(0, 2) = 3;
+  m(1, 0) = 0;
+  m(1, 1) = 4;
+  m(1, 2) = 2;
+  m(2, 0) = 5;
+  m(2, 1) = 2;
+  m(2, 2) = 1;
+  const double expected[3][3] = {{0, 10, -20}, {4, -14, 8}, {-8, -2, 4}};
+  S21Matrix result = m.CalcComplements();
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(result(i, j), expected[i][j], 1e-12);
+}
+// CalcComplements of a singular matrix still has a nonzero adjugate
+TEST(S21MatrixTest, CalcComplementsSingular) {
+  S21Matrix m(3, 3);
+  m(0, 0) = 1;
+  m(0, 1) = 2;
+  m(0, 2) = 3;
+  m(1, 0) = 2;
+  m(1, 1) = 4;
+  m(1, 2) = 6;
+  m(2, 0) = 1;
+  m(2, 1) = 0;
+  m(2, 2) = 1;
+  const double expected[3][3] = {{4, 4, -4}, {-2, -2, 2}, {0, 0, 0}};
+  S21Matrix result = m.CalcComplements();
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(result(i, j), expected[i][j], 1e-12);
+}
+// Inverse of a 50x50 matrix
+TEST(S21MatrixTest, InverseLarge) {
+  const int n = 50;
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = 1.0 / (1 + std::abs(i - j));
+  S21Matrix product = m * m.InverseMatrix();
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-10);
+}
+// A tiny determinant alone does not make a matrix singular
+TEST(S21MatrixTest, InverseSmallDeterminant) {
+  S21Matrix m(4, 4);
+  for (int i = 0; i < 4; ++i) m(i, i) = 1e-3;
+  S21Matrix result = m.InverseMatrix();
+  EXPECT_NEAR(result(2, 2), 1e3, 1e-9);
+  EXPECT_EQ(result(2, 1), 0.0);
+}
+// Singular and numerically singular matrices
+TEST(S21MatrixTest, InverseSingular) {
+  S21Matrix m(3, 3);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) m(i, j) = i * 3 + j + 1;
+  EXPECT_THROW(m.InverseMatrix(), MatrixException);
+  S21Matrix zero(2, 2);
+  EXPECT_THROW(zero.InverseMatrix(), MatrixException);
+}
 // Inverse exception
 TEST(S21MatrixTest, InvalidInverseSquare) {
   S21Matrix m1(3, 4);
   EXPECT_THROW(m1.InverseMatrix(), MatrixException);
 }
+// every element type of the library
+template <typename T>
+class S21BasicMatrixTest : public ::testing::Test {};
+using ElementTypes =
+    ::testing::Types<float, double, long double, std::complex<double>>;
+TYPED_TEST_SUITE(S21BasicMatrixTest, ElementTypes);
+
+TYPED_TEST(S21BasicMatrixTest, Arithmetic) {
+  using T = TypeParam;
+  S21BasicMatrix<T> a(3, 3), b(3, 3);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) {
+      a(i, j) = T(i + j);
+      b(i, j) = T(i * j);
+    }
+  S21BasicMatrix<T> sum = a + b * 2 - a;
+  S21BasicMatrix<T> product = a * b;
+  a *= T(3);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(sum(i, j), T(2 * i * j));
+      EXPECT_EQ(a(i, j), T(3 * (i + j)));
+      T expected = T(0);
+      for (int k = 0; k < 3; ++k) expected += T((i + k) * k * j);
+      EXPECT_EQ(product(i, j), expected);
+    }
+}
+
+TYPED_TEST(S21BasicMatrixTest, EqMatrixUsesTypeEpsilon) {
+  using T = TypeParam;
+  using Real = typename S21BasicMatrix<T>::Real;
+  S21BasicMatrix<T> a(2, 2), b(2, 2);
+  b(1, 1) = T(S21BasicMatrix<T>::kEpsilon / Real(2));
+  EXPECT_TRUE(a == b);
+  b(1, 1) = T(S21BasicMatrix<T>::kEpsilon * Real(2));
+  EXPECT_FALSE(a == b);
+}
+
+TYPED_TEST(S21BasicMatrixTest, InverseAndDeterminant) {
+  using T = TypeParam;
+  using Real = typename S21BasicMatrix<T>::Real;
+  const int n = 70;
+  S21BasicMatrix<T> m(n, n), identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = T(1);
+    for (int j = 0; j < n; ++j)
+      m(i, j) = i == j ? T(n) : T((i * 7 + j * 3) % 5 * Real(0.25));
+  }
+  S21BasicMatrix<T> check = m * m.InverseMatrix();
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      EXPECT_NEAR(std::abs(check(i, j) - identity(i, j)), 0.0, 1e-4);
+  S21BasicMatrix<T> diagonal(3, 3);
+  diagonal(0, 0) = T(2);
+  diagonal(1, 1) = T(3);
+  diagonal(2, 2) = T(4);
+  EXPECT_NEAR(std::abs(diagonal.Determinant() - T(24)), 0.0, 1e-4);
+}
+
+TEST(S21MatrixTest, ComplexElements) {
+  using C = std::complex<double>;
+  S21MatrixC m(2, 2);
+  m(0, 0) = C(0, 1);
+  m(0, 1) = C(2, 0);
+  m(1, 0) = C(1, 1);
+  m(1, 1) = C(0, -1);
+  // det = i * -i - 2 * (1 + i) = -1 - 2i
+  EXPECT_EQ(m.Determinant(), C(-1, -2));
+  S21MatrixC product = m * m.InverseMatrix();
+  EXPECT_NEAR(std::abs(product(0, 0) - C(1, 0)), 0.0, 1e-12);
+  EXPECT_NEAR(std::abs(product(0, 1)), 0.0, 1e-12);
+  S21MatrixC scaled = m * C(0, 1);
+  EXPECT_EQ(scaled(0, 0), C(-1, 0));
+}
+
+// fixed-size matrices
+template <typename M, typename S, typename = void>
+struct CanAdd : std::false_type {};
+template <typename M, typename S>
+struct CanAdd<M, S,
+              std::void_t<decltype(std::declval<M>() + std::declval<S>())>>
+    : std::true_type {};
+template <typename M, typename S, typename = void>
+struct CanCompare : std::false_type {};
+template <typename M, typename S>
+struct CanCompare<
+    M, S, std::void_t<decltype(std::declval<M>() == std::declval<S>())>>
+    : std::true_type {};
+
+TEST(S21MatrixTest, FixedScalarDoesNotConvert) {
+  static_assert(CanAdd<S21Matrix2, S21Matrix2>::value);
+  static_assert(!CanAdd<S21Matrix2, double>::value);
+  static_assert(!CanAdd<S21Matrix2, int>::value);
+  static_assert(CanCompare<S21Matrix2, S21Matrix2>::value);
+  static_assert(!CanCompare<S21Matrix2, double>::value);
+  static_assert(!std::is_convertible<double, S21Matrix2>::value);
+  static_assert(std::is_constructible<S21Matrix2, double>::value);
+  EXPECT_TRUE(S21Matrix2(1.0) == S21Matrix2(1, 0, 0, 0));
+}
+
+TEST(S21MatrixTest, FixedConstexpr) {
+  constexpr S21Matrix2 a(1, 2, 3, 4);
+  constexpr S21Matrix2 b = a * 2.0 - a + S21Matrix2::Identity();
+  static_assert(b(0, 0) == 2.0 && b(1, 0) == 3.0 && b(1, 1) == 5.0);
+  static_assert(a.Determinant() == -2.0);
+  constexpr S21FixedMatrix<2, 3> c(1, 0, 2, 0, 1, 3);
+  constexpr S21FixedMatrix<2, 3> product = a * c;
+  static_assert(product(1, 2) == 3 * 2 + 4 * 3);
+  static_assert(c.Transpose()(2, 1) == 3.0);
+  constexpr S21Matrix2 inverse = a.InverseMatrix();
+  static_assert((a * inverse).EqMatrix(S21Matrix2::Identity()));
+  EXPECT_EQ(b(0, 1), 2.0);
+}
+
+TEST(S21MatrixTest, FixedDeterminantAndInverse) {
+  S21Matrix3 m3(2, 5, 7, 6, 3, 4, 5, -2, -3);
+  EXPECT_NEAR(m3.Determinant(), -1.0, 1e-12);
+  EXPECT_TRUE(m3 * m3.InverseMatrix() == S21Matrix3::Identity());
+  S21Matrix4 m4(4, 1, 2, 3, 1, 5, 1, 2, 2, 1, 6, 1, 3, 2, 1, 7);
+  S21Matrix dynamic = m4.ToMatrix();
+  EXPECT_NEAR(m4.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(S21Matrix4(dynamic.InverseMatrix()) == m4.InverseMatrix());
+  EXPECT_TRUE(S21Matrix4(dynamic.CalcComplements()) == m4.CalcComplements());
+  S21FixedMatrix<6, 6> m6;
+  for (int i = 0; i < 6; ++i)
+    for (int j = 0; j < 6; ++j) m6(i, j) = i == j ? 6.0 : (i + 2 * j) % 3;
+  S21Matrix d6 = m6.ToMatrix();
+  EXPECT_NEAR(m6.Determinant(), d6.Determinant(), 1e-6);
+  EXPECT_TRUE((S21FixedMatrix<6, 6>(d6.InverseMatrix()) == m6.InverseMatrix()));
+  EXPECT_THROW(S21Matrix2(1, 2, 2, 4).InverseMatrix(), MatrixException);
+  EXPECT_THROW((S21FixedMatrix<6, 6>().InverseMatrix()), MatrixException);
+  EXPECT_EQ((S21FixedMatrix<6, 6>().Determinant()), 0.0);
+}
+
+TEST(S21MatrixTest, FixedConversion) {
+  S21Matrix dynamic(2, 3);
+  dynamic(1, 2) = 5.0;
+  S21FixedMatrix<2, 3> fixed(dynamic);
+  EXPECT_EQ(fixed(1, 2), 5.0);
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed) == dynamic);
+  EXPECT_THROW(S21Matrix3{dynamic}, MatrixException);
+  S21Matrix3 minor_source(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  S21FixedMatrix<2, 2> minor = minor_source.Minor(1, 1);
+  EXPECT_TRUE(minor == S21Matrix2(1, 3, 7, 9));
+}
+
+// cache-oblivious, in-place and lazy transposes
+TEST(S21MatrixTest, TransposeShapes) {
+  for (int rows : {1, 5, 17, 64, 130}) {
+    for (int cols : {1, 9, 33, 200}) {
+      S21Matrix m(rows, cols);
+      for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j) m(i, j) = i * 1000 + j;
+      S21Matrix t = m.Transpose();
+      ASSERT_EQ(t.get_rows(), cols);
+      for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j) ASSERT_EQ(t(j, i), i * 1000 + j);
+      EXPECT_TRUE(S21Matrix(m.TransposedView()) == t);
+      if (rows != cols) {
+        EXPECT_THROW(m.TransposeInPlace(), MatrixException);
+      }
+    }
+  }
+}
+
+TEST(S21MatrixTest, TransposeInPlace) {
+  for (int n : {1, 2, 16, 17, 100}) {
+    S21Matrix m(n, n);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) m(i, j) = i * 1000 + j;
+    S21Matrix expected = m.Transpose();
+    const double *storage = m.data();
+    m.TransposeInPlace();
+    EXPECT_EQ(m.data(), storage);
+    EXPECT_TRUE(m == expected);
+  }
+}
+
+TEST(S21MatrixTest, TransposedViewExpression) {
+  S21Matrix a(3, 3), b(3, 3);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) {
+      a(i, j) = i * 3 + j;
+      b(i, j) = 1.0;
+    }
+  S21TransposeView<double> view = a.TransposedView();
+  EXPECT_EQ(view.get_rows(), 3);
+  EXPECT_EQ(view(0, 2), a(2, 0));
+  S21Matrix sum = b + a.TransposedView() * 2.0;
+  EXPECT_EQ(sum(0, 1), 1.0 + 2.0 * a(1, 0));
+  // Reading the transpose of the destination goes through a temporary.
+  S21Matrix expected = a + a.Transpose();
+  a = a + a.TransposedView();
+  EXPECT_TRUE(a == expected);
+}
+
+TEST(S21MatrixTest, BlockRowColViews) {
+  S21Matrix a(4, 5);
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 5; ++j) a(i, j) = i * 5 + j;
+  size_t before = allocations;
+  S21MatrixView block = a.Block(1, 2, 2, 3);
+  S21MatrixView row = a.Row(3);
+  S21MatrixView col = a.Col(4);
+  EXPECT_EQ(allocations, before);
+  EXPECT_EQ(block.get_rows(), 2);
+  EXPECT_EQ(block.get_cols(), 3);
+  EXPECT_EQ(block(1, 2), a(2, 4));
+  EXPECT_EQ(row.get_rows(), 1);
+  EXPECT_EQ(row(0, 1), a(3, 1));
+  EXPECT_EQ(col.get_cols(), 1);
+  EXPECT_EQ(col(2, 0), a(2, 4));
+  EXPECT_EQ(block.Col(0)(1, 0), a(2, 2));
+  // Writes go to the viewed matrix.
+  block(0, 0) = -1.0;
+  EXPECT_EQ(a(1, 2), -1.0);
+  S21Matrix copy = block;
+  EXPECT_TRUE(block.EqMatrix(copy));
+  EXPECT_THROW(a.Block(3, 0, 2, 1), MatrixException);
+  EXPECT_THROW(a.Row(4), MatrixException);
+  EXPECT_THROW(a.Col(-1), MatrixException);
+  EXPECT_THROW(block(2, 0), MatrixException);
+  const S21Matrix &ca = a;
+  S21ConstMatrixView<double> read_only = ca.Block(0, 0, 2, 2);
+  EXPECT_EQ(read_only(1, 1), a(1, 1));
+}
+
+TEST(S21MatrixTest, ViewInPlaceArithmetic) {
+  S21Matrix a(3, 4), b(2, 2);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j) a(i, j) = i * 4 + j;
+  b(0, 0) = 1.0, b(0, 1) = 2.0, b(1, 0) = 3.0, b(1, 1) = 4.0;
+  S21Matrix expected = a;
+  S21MatrixView block = a.Block(1, 1, 2, 2);
+  block += b;
+  block *= 2.0;
+  block.Axpy(-1.0, b);
+  block -= b * 0.5;
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 2; ++j)
+      expected(i + 1, j + 1) =
+          (expected(i + 1, j + 1) + b(i, j)) * 2.0 - 1.5 * b(i, j);
+  EXPECT_TRUE(a == expected);
+  EXPECT_THROW(block += a, MatrixException);
+  // Rows of one matrix: the whole row is read before it is overwritten.
+  a.Row(0) = a.Row(2);
+  a.Row(2) += a.Row(0);
+  EXPECT_EQ(a(0, 3), expected(2, 3));
+  EXPECT_EQ(a(2, 3), 2.0 * expected(2, 3));
+  // Overlapping blocks shifted against each other go through a temporary.
+  S21Matrix c(1, 4);
+  for (int j = 0; j < 4; ++j) c(0, j) = j;
+  c.Block(0, 1, 1, 3) = c.Block(0, 0, 1, 3);
+  EXPECT_EQ(c(0, 1), 0.0);
+  EXPECT_EQ(c(0, 2), 1.0);
+  EXPECT_EQ(c(0, 3), 2.0);
+  // A matrix can be assigned from a view of itself.
+  c = c.Block(0, 2, 1, 2);
+  EXPECT_EQ(c.get_cols(), 2);
+  EXPECT_EQ(c(0, 0), 1.0);
+}
+
+TEST(S21MatrixTest, MinorView) {
+  S21Matrix a(4, 4);
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j) a(i, j) = (i + 1) * (j + 2) % 7;
+  S21Matrix minor(3, 3);
+  for (int r = 0; r < 4; ++r)
+    for (int c = 0; c < 4; ++c) {
+      S21MinorView<double> view = a.MinorView(r, c);
+      a.Minor(minor, r, c);
+      EXPECT_TRUE(minor == S21Matrix(view));
+      EXPECT_EQ(view(2, 2), a(r < 3 ? 3 : 2, c < 3 ? 3 : 2));
+    }
+  EXPECT_THROW(a.MinorView(4, 0), MatrixException);
+  EXPECT_THROW(S21Matrix(1, 3).MinorView(0, 0), MatrixException);
+  // Written back into its own matrix through a temporary.
+  S21Matrix expected = a.MinorView(0, 0);
+  a.Block(0, 0, 3, 3) = a.MinorView(0, 0);
+  EXPECT_TRUE(S21Matrix(a.Block(0, 0, 3, 3)) == expected);
+}
+
+static S21Matrix Conditioned(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j) m(i, j) = 1.0 / (1 + std::abs(i - j));
+  return m;
+}
+
+TEST(S21MatrixTest, VersionBumpedByMutators) {
+  S21Matrix m = Conditioned(4), other = Conditioned(4);
+  const S21Matrix &view = m;
+  uint64_t version = m.get_version();
+  auto bumped = [&] {
+    bool changed = m.get_version() != version;
+    version = m.get_version();
+    return changed;
+  };
+  view(1, 1);
+  view.row(2);
+  view.data();
+  view.Block(0, 0, 2, 2);
+  m.NormOne();
+  m.Determinant();
+  m.InverseMatrix();
+  EXPECT_FALSE(bumped());
+  m(1, 1);
+  EXPECT_TRUE(bumped());
+  m.set_element(0, 0, 2);
+  EXPECT_TRUE(bumped());
+  m.SumMatrix(other);
+  EXPECT_TRUE(bumped());
+  m.SubMatrix(other);
+  EXPECT_TRUE(bumped());
+  m.MulNumber(2);
+  EXPECT_TRUE(bumped());
+  m.MulMatrix(other);
+  EXPECT_TRUE(bumped());
+  m.TransposeInPlace();
+  EXPECT_TRUE(bumped());
+  m = other;
+  EXPECT_TRUE(bumped());
+  m = other + other;
+  EXPECT_TRUE(bumped());
+  m.Row(0) *= 2.0;
+  EXPECT_TRUE(bumped());
+  m.set_cols(5);
+  EXPECT_TRUE(bumped());
+}
+
+TEST(S21MatrixTest, CachedResultsFollowMutations) {
+  S21Matrix m = Conditioned(6);
+  double det = m.Determinant();
+  S21Matrix inverse = m.InverseMatrix();
+  EXPECT_EQ(m.Determinant(), det);
+  EXPECT_TRUE(m.InverseMatrix() == inverse);
+  // A cached result handed out is a copy.
+  S21Matrix changed = m.InverseMatrix();
+  changed(0, 0) = 100;
+  EXPECT_TRUE(m.InverseMatrix() == inverse);
+  m.MulNumber(2);
+  EXPECT_NEAR(m.Determinant(), det * 64, 1e-12);
+  EXPECT_TRUE(m.InverseMatrix() * 2.0 == inverse);
+  for (int j = 0; j < 6; ++j) m.set_element(0, j, 0);
+  EXPECT_EQ(m.Determinant(), 0.0);
+  EXPECT_THROW(m.InverseMatrix(), MatrixException);
+  // Written through element access and a view after the results were
+  // cached.
+  for (int j = 0; j < 6; ++j) m(0, j) = j == 0 ? 2 : 0;
+  EXPECT_NEAR(m.Determinant(), S21Matrix(m).Determinant(), 1e-12);
+  EXPECT_NO_THROW(m.InverseMatrix());
+  m.Row(1) *= 0.0;
+  EXPECT_EQ(m.Determinant(), 0.0);
+  // Written through a pointer taken before the results were cached.
+  S21Matrix n = Conditioned(3);
+  double *data = n.data();
+  double before = n.Determinant();
+  data[0] = 5;
+  EXPECT_EQ(n.Determinant(), before);
+  n.ReleaseCache();
+  EXPECT_NE(n.Determinant(), before);
+  EXPECT_NEAR(n.Determinant(), S21Matrix(n).Determinant(), 1e-12);
+}
+
+TEST(S21MatrixTest, CachedResultsMoveWithTheMatrix) {
+  S21Matrix m = Conditioned(5);
+  S21Matrix inverse = m.InverseMatrix();
+  S21Matrix moved(std::move(m));
+  EXPECT_TRUE(moved.InverseMatrix() == inverse);
+  // The moved-from matrix is left without them.
+  m = Conditioned(4);
+  EXPECT_TRUE(m.InverseMatrix() == Conditioned(4).InverseMatrix());
+  S21Matrix target = Conditioned(3);
+  target.InverseMatrix();
+  target = std::move(moved);
+  EXPECT_TRUE(target.InverseMatrix() == inverse);
+  EXPECT_EQ(target.get_rows(), 5);
+}
+
+TEST(S21MatrixTest, ConcurrentCachedReaders) {
+  S21Matrix m = Conditioned(40);
+  const double det = S21Matrix(m).Determinant();
+  const S21Matrix inverse = S21Matrix(m).InverseMatrix();
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t)
+    readers.emplace_back([&] {
+      for (int i = 0; i < 20; ++i) {
+        if (m.Determinant() != det) ++mismatches;
+        if (!(m.InverseMatrix() == inverse)) ++mismatches;
+        if (i % 5 == 0) m.ReleaseCache();
+      }
+    });
+  for (std::thread &reader : readers) reader.join();
+  EXPECT_EQ(mismatches, 0);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
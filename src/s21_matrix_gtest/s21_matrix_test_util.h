@@ -0,0 +1,20 @@
+#ifndef S21_MATRIX_TEST_UTIL
+#define S21_MATRIX_TEST_UTIL
+
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+
+// Deterministic test matrix: elements in [-0.5, 0.5) that vary with the
+// position and `seed`, plus `diagonal` on the main diagonal. A diagonal
+// larger than the number of columns makes the matrix diagonally dominant,
+// hence invertible and well conditioned.
+inline S21Matrix Filled(int rows, int cols, int seed = 0,
+                        double diagonal = 0) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+      m(i, j) = ((i * 7 + j * 3 + seed) % 11) / 11.0 - 0.5 +
+                (i == j ? diagonal : 0);
+  return m;
+}
+
+#endif  // S21_MATRIX_TEST_UTIL
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_matrix_text.h"
+#include "s21_matrix_test_util.h"
+
+TEST(S21MatrixTextTest, CsvRoundTripIsExact) {
+  S21Matrix m = Filled(40, 7);
+  std::stringstream text;
+  S21MatrixText::WriteCsv(text, m);
+  S21TextOptions options;
+  // Chunks smaller than a line still split only on line boundaries.
+  options.chunk_bytes = 16;
+  S21Matrix read = S21MatrixText::ReadCsv(text, options);
+  ASSERT_EQ(read.get_rows(), 40);
+  ASSERT_EQ(read.get_cols(), 7);
+  for (int i = 0; i < 40; ++i)
+    for (int j = 0; j < 7; ++j) EXPECT_EQ(read(i, j), m(i, j));
+}
+
+TEST(S21MatrixTextTest, CsvSyntax) {
+  std::istringstream text("a,b,c\r\n1, +2 ,-3e2\r\n\n  4.5,5,6\n");
+  S21TextOptions options;
+  options.header = true;
+  options.parallel = true;
+  S21Matrix m = S21MatrixText::ReadCsv(text, options);
+  ASSERT_EQ(m.get_rows(), 2);
+  EXPECT_EQ(m(0, 1), 2.0);
+  EXPECT_EQ(m(0, 2), -300.0);
+  EXPECT_EQ(m(1, 0), 4.5);
+
+  std::istringstream blanks("1 2\t 3\n4  5 6");
+  options = S21TextOptions();
+  options.delimiter = ' ';
+  m = S21MatrixText::ReadCsv(blanks, options);
+  EXPECT_EQ(m.get_cols(), 3);
+  EXPECT_EQ(m(1, 2), 6.0);
+
+  std::istringstream ragged("1,2\n3\n");
+  EXPECT_THROW(S21MatrixText::ReadCsv(ragged), MatrixException);
+  std::istringstream bad("1,2\n3,x\n");
+  try {
+    S21MatrixText::ReadCsv(bad);
+    FAIL();
+  } catch (const MatrixException &e) {
+    EXPECT_STREQ(e.what(), "ReadCsv: Line 2: Invalid number.");
+  }
+  std::istringstream empty("\n\n");
+  EXPECT_THROW(S21MatrixText::ReadCsv(empty), MatrixException);
+}
+
+TEST(S21MatrixTextTest, StreamCsvChunks) {
+  std::stringstream text;
+  S21MatrixText::WriteCsv(text, Filled(100, 3), ';');
+  S21TextOptions options;
+  options.delimiter = ';';
+  options.chunk_bytes = 256;
+  int rows = 0, chunks = 0;
+  double sum = 0.0;
+  S21MatrixText::StreamCsv(
+      text,
+      [&](S21BasicMatrixView<const double> block) {
+        ++chunks;
+        for (int i = 0; i < block.get_rows(); ++i) sum += block(i, 0);
+        rows += block.get_rows();
+      },
+      options);
+  EXPECT_EQ(rows, 100);
+  EXPECT_GT(chunks, 1);
+  double expected = 0.0;
+  S21Matrix m = Filled(100, 3);
+  for (int i = 0; i < 100; ++i) expected += m(i, 0);
+  EXPECT_DOUBLE_EQ(sum, expected);
+}
+
+TEST(S21MatrixTextTest, MatrixMarketArray) {
+  S21Matrix m = Filled(4, 3);
+  std::stringstream text;
+  S21MatrixText::WriteMatrixMarket(text, m);
+  EXPECT_TRUE(S21MatrixText::ReadMatrixMarket(text) == m);
+
+  std::istringstream symmetric(
+      "%%MatrixMarket matrix array real symmetric\n% comment\n3 3\n"
+      "1\n2\n3\n4\n5\n6\n");
+  S21Matrix s = S21MatrixText::ReadMatrixMarket(symmetric);
+  EXPECT_EQ(s(0, 2), 3.0);
+  EXPECT_EQ(s(2, 0), 3.0);
+  EXPECT_EQ(s(2, 1), 5.0);
+  EXPECT_EQ(s(2, 2), 6.0);
+
+  std::istringstream skew(
+      "%%MatrixMarket matrix array real skew-symmetric\n2 2\n7\n");
+  S21Matrix k = S21MatrixText::ReadMatrixMarket(skew);
+  EXPECT_EQ(k(1, 0), 7.0);
+  EXPECT_EQ(k(0, 1), -7.0);
+  EXPECT_EQ(k(0, 0), 0.0);
+}
+
+TEST(S21MatrixTextTest, MatrixMarketCoordinate) {
+  std::istringstream text(
+      "%%MatrixMarket matrix coordinate real symmetric\n"
+      "%\n4 4 3\n1 1 2.5\n3 1 -1\n4 4 1e3\n");
+  S21TextOptions options;
+  options.parallel = true;
+  S21SparseMatrix sparse = S21MatrixText::ReadMatrixMarketSparse(text, options);
+  EXPECT_EQ(sparse.NonZeros(), 4u);
+  EXPECT_EQ(sparse(0, 2), -1.0);
+  EXPECT_EQ(sparse(2, 0), -1.0);
+  EXPECT_EQ(sparse(3, 3), 1000.0);
+
+  std::stringstream out;
+  S21MatrixText::WriteMatrixMarket(out, sparse);
+  S21Matrix dense = S21MatrixText::ReadMatrixMarket(out);
+  EXPECT_TRUE(dense == sparse.ToDense());
+
+  std::istringstream pattern(
+      "%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 1\n");
+  S21Matrix p = S21MatrixText::ReadMatrixMarket(pattern);
+  EXPECT_EQ(p(0, 2), 1.0);
+  EXPECT_EQ(p(1, 0), 1.0);
+}
+
+TEST(S21MatrixTextTest, MatrixMarketErrors) {
+  const char *inputs[] = {
+      "",
+      "%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n",
+      "%%MatrixMarket matrix coordinate real hermitian\n1 1 1\n1 1 1\n",
+      "%%MatrixMarket matrix coordinate real general\n2 2\n",
+      "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n",
+      "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 1\n2 2 2\n",
+      "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n",
+      "%%MatrixMarket matrix array real general\n2 1\n1\n",
+      "%%MatrixMarket matrix array real symmetric\n2 3\n",
+      "not a header\n",
+  };
+  for (const char *input : inputs) {
+    std::istringstream text(input);
+    EXPECT_THROW(S21MatrixText::ReadMatrixMarket(text), MatrixException)
+        << input;
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "../s21_matrix_plus/s21_matrix_exception.h"
+#include "../s21_matrix_plus/s21_matrix_tiled.h"
+#include "s21_matrix_test_util.h"
+
+// Odd shapes against tiles of 8 so that every operation crosses partial
+// edge tiles; files go to the gtest temporary directory.
+static const int kTile = 8;
+static const size_t kTileBytes = kTile * kTile * sizeof(double);
+
+static std::string TempPath(const char *name) {
+  return ::testing::TempDir() + "s21_tiled_" + name + ".bin";
+}
+
+static S21TiledMatrix Store(const char *name, const S21Matrix &m,
+                            S21TileCache &cache) {
+  S21TiledMatrix tiled(TempPath(name), m.get_rows(), m.get_cols(), cache,
+                       kTile);
+  tiled.WriteBlock(0, 0, m);
+  return tiled;
+}
+
+static double MaxDifference(const S21TiledMatrix &tiled, const S21Matrix &m) {
+  S21Matrix read = tiled.ReadBlock(0, 0, tiled.get_rows(), tiled.get_cols());
+  double result = 0;
+  for (int i = 0; i < m.get_rows(); ++i)
+    for (int j = 0; j < m.get_cols(); ++j)
+      result = std::max(result, std::abs(read(i, j) - m(i, j)));
+  return result;
+}
+
+TEST(S21TiledTest, BlocksAndElements) {
+  S21TileCache cache(64 * kTileBytes);
+  S21Matrix m = Filled(37, 29, 1);
+  S21TiledMatrix tiled = Store("blocks", m, cache);
+  EXPECT_EQ(tiled.get_rows(), 37);
+  EXPECT_EQ(tiled.get_cols(), 29);
+  EXPECT_EQ(tiled.get_tile(), kTile);
+  EXPECT_EQ(MaxDifference(tiled, m), 0);
+  S21Matrix block = tiled.ReadBlock(5, 3, 20, 17);
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 17; ++j) {
+      EXPECT_EQ(block(i, j), m(i + 5, j + 3));
+    }
+  }
+  tiled.set_element(36, 28, 42);
+  EXPECT_EQ(tiled(36, 28), 42);
+  EXPECT_THROW(tiled(37, 0), MatrixException);
+  EXPECT_THROW(tiled.set_element(0, -1, 1), MatrixException);
+  EXPECT_THROW(tiled.ReadBlock(30, 0, 8, 1), MatrixException);
+  EXPECT_THROW(tiled.ReadBlock(0, 0, 0, 1), MatrixException);
+  EXPECT_THROW(tiled.WriteBlock(0, 20, m), MatrixException);
+  EXPECT_THROW(S21TiledMatrix(TempPath("bad"), 0, 3, cache), MatrixException);
+}
+
+TEST(S21TiledTest, EvictionKeepsBudget) {
+  // Room for three tiles of the 5 x 4 tile grid: every tile is written back
+  // and read again, and the data survives.
+  S21TileCache cache(3 * kTileBytes);
+  S21Matrix m = Filled(37, 29, 2);
+  S21TiledMatrix tiled = Store("evict", m, cache);
+  for (int i = 0; i < 37; ++i) {
+    for (int j = 0; j < 29; ++j) {
+      EXPECT_EQ(tiled(i, j), m(i, j));
+    }
+  }
+  EXPECT_LE(cache.get_peak_bytes(), cache.get_budget());
+  EXPECT_LE(cache.get_resident_bytes(), cache.get_budget());
+  EXPECT_GT(cache.get_misses(), 20u);
+  EXPECT_GT(cache.get_hits(), 0u);
+  tiled.Flush();
+  S21TiledMatrix moved = std::move(tiled);
+  EXPECT_EQ(moved(20, 20), m(20, 20));
+}
+
+TEST(S21TiledTest, Elementwise) {
+  S21TileCache cache(4 * kTileBytes);
+  S21Matrix a = Filled(37, 29, 3), b = Filled(37, 29, 4);
+  S21TiledMatrix ta = Store("sum_a", a, cache), tb = Store("sum_b", b, cache);
+  ta.SumMatrix(tb);
+  EXPECT_LT(MaxDifference(ta, a + b), 1e-15);
+  ta.SubMatrix(tb);
+  ta.SubMatrix(tb);
+  EXPECT_LT(MaxDifference(ta, a - b), 1e-15);
+  ta.MulNumber(-2.5);
+  EXPECT_LT(MaxDifference(ta, (a - b) * -2.5), 1e-15);
+  EXPECT_LE(cache.get_peak_bytes(), cache.get_budget());
+  S21TiledMatrix wide(TempPath("wide"), 37, 30, cache, kTile);
+  EXPECT_THROW(ta.SumMatrix(wide), MatrixException);
+  S21TiledMatrix coarse(TempPath("coarse"), 37, 29, cache, 16);
+  EXPECT_THROW(ta.SubMatrix(coarse), MatrixException);
+}
+
+TEST(S21TiledTest, TransposeAndMultiply) {
+  // A block row of A is 4 tiles; with 3 more the product reuses it.
+  S21TileCache cache(7 * kTileBytes);
+  S21Matrix a = Filled(37, 29, 5), b = Filled(29, 21, 6);
+  S21TiledMatrix ta = Store("mul_a", a, cache), tb = Store("mul_b", b, cache);
+  S21TiledMatrix t = ta.Transpose(TempPath("mul_t"));
+  EXPECT_EQ(t.get_rows(), 29);
+  EXPECT_EQ(t.get_cols(), 37);
+  EXPECT_EQ(MaxDifference(t, a.Transpose()), 0);
+  S21TiledMatrix c = ta.MulMatrix(tb, TempPath("mul_c"));
+  EXPECT_EQ(c.get_rows(), 37);
+  EXPECT_EQ(c.get_cols(), 21);
+  EXPECT_LT(MaxDifference(c, a * b), 1e-13);
+  EXPECT_LE(cache.get_peak_bytes(), cache.get_budget());
+  EXPECT_THROW(ta.MulMatrix(ta, TempPath("mul_bad")), MatrixException);
+}
+
+TEST(S21TiledTest, BudgetTooSmall) {
+  S21TileCache cache(2 * kTileBytes);
+  S21TiledMatrix a(TempPath("small_a"), 16, 16, cache, kTile);
+  S21TiledMatrix b(TempPath("small_b"), 16, 16, cache, kTile);
+  a.set_element(0, 0, 1);
+  // A product pins three tiles at once.
+  EXPECT_THROW(a.MulMatrix(b, TempPath("small_c")), MatrixException);
+  // Nothing stays pinned after the failure.
+  a.SumMatrix(b);
+  EXPECT_EQ(a(0, 0), 1);
+  EXPECT_LE(cache.get_resident_bytes(), cache.get_budget());
+}
+
+TEST(S21TiledTest, ComplexTiles) {
+  using C = std::complex<double>;
+  S21TileCache cache(1 << 20);
+  S21BasicMatrix<C> m(10, 9);
+  for (int i = 0; i < 10; ++i)
+    for (int j = 0; j < 9; ++j) m(i, j) = C(i - j, i * j % 4);
+  S21BasicTiledMatrix<C> tiled(TempPath("complex"), 10, 9, cache, 4);
+  tiled.WriteBlock(0, 0, m);
+  S21BasicTiledMatrix<C> square = tiled.MulMatrix(
+      tiled.Transpose(TempPath("complex_t")), TempPath("complex_c"));
+  EXPECT_TRUE(square.ReadBlock(0, 0, 10, 10) == m * m.Transpose());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  const char *names[] = {
+      "blocks",  "bad",     "evict",   "sum_a",   "sum_b",     "wide",
+      "coarse",  "mul_a",   "mul_b",   "mul_t",   "mul_c",     "mul_bad",
+      "small_a", "small_b", "small_c", "complex", "complex_t", "complex_c"};
+  for (const char *name : names) std::remove(TempPath(name).c_str());
+  return result;
+}
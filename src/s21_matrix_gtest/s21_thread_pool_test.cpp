@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "../s21_matrix_plus/s21_matrix_lu.h"
+#include "../s21_matrix_plus/s21_matrix_oop.h"
+#include "../s21_matrix_plus/s21_thread_pool.h"
+#include "s21_matrix_test_util.h"
+
+TEST(S21ThreadPoolTest, ParallelForCoversRangeOnce) {
+  S21ThreadPool pool(4);
+  EXPECT_EQ(pool.get_thread_count(), 4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(1000, 7, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) hits[i]++;
+  });
+  for (auto &hit : hits) EXPECT_EQ(hit.load(), 1);
+}
+
+TEST(S21ThreadPoolTest, NestedParallelFor) {
+  S21ThreadPool pool(3);
+  std::atomic<int64_t> sum(0);
+  pool.ParallelFor(16, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i)
+      pool.ParallelFor(100, 1, [&](int64_t b, int64_t e) { sum += e - b; });
+  });
+  EXPECT_EQ(sum.load(), 1600);
+}
+
+TEST(S21ThreadPoolTest, ExceptionIsRethrown) {
+  S21ThreadPool pool(4);
+  EXPECT_THROW(pool.ParallelFor(100, 1,
+                                [](int64_t begin, int64_t) {
+                                  if (begin == 0)
+                                    throw std::runtime_error("task failed");
+                                }),
+               std::runtime_error);
+}
+
+TEST(S21ThreadPoolTest, ThreadCountAtRuntime) {
+  S21ThreadPool pool(1);
+  EXPECT_FALSE(pool.IsParallel(1 << 30));
+  pool.set_thread_count(5);
+  EXPECT_EQ(pool.get_thread_count(), 5);
+  pool.set_serial_threshold(100);
+  EXPECT_FALSE(pool.IsParallel(99));
+  EXPECT_TRUE(pool.IsParallel(100));
+  EXPECT_THROW(pool.set_thread_count(-1), MatrixException);
+}
+
+TEST(S21ThreadPoolTest, ScopeOverridesDefault) {
+  S21ThreadPool pool(2);
+  EXPECT_EQ(&S21ThreadPool::Current(), &S21ThreadPool::Default());
+  {
+    S21ThreadPoolScope scope(pool);
+    EXPECT_EQ(&S21ThreadPool::Current(), &pool);
+  }
+  EXPECT_EQ(&S21ThreadPool::Current(), &S21ThreadPool::Default());
+}
+
+// A task run while its thread waits in ParallelFor may start another
+// product on that thread; the in-place product must not share its buffer.
+TEST(S21ThreadPoolTest, NestedMulAssign) {
+  S21ThreadPool pool(4);
+  pool.set_serial_threshold(0);
+  S21ThreadPoolScope scope(pool);
+  const S21Matrix b = Filled(200, 200, 1);
+  std::vector<S21Matrix> v, expected;
+  for (int k = 0; k < 16; ++k) {
+    v.push_back(Filled(200, 200, k + 2));
+    expected.push_back(v.back() * b);
+  }
+  pool.ParallelFor(16, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; ++k) v[k] *= b;
+  });
+  for (int k = 0; k < 16; ++k) EXPECT_TRUE(v[k] == expected[k]);
+}
+
+// Every parallel matrix operation must agree with its serial run.
+TEST(S21ThreadPoolTest, MatrixOperationsMatchSerial) {
+  S21Matrix a = Filled(150, 170, 3);
+  S21Matrix b = Filled(170, 90, 5);
+  S21Matrix c = Filled(150, 170, 11);
+  S21Matrix sq = Filled(120, 120, 17, 100);
+
+  S21ThreadPool serial(1);
+  S21ThreadPool parallel(4);
+  parallel.set_serial_threshold(0);
+  S21Matrix results[2][5];
+  S21ThreadPool *pools[2] = {&serial, &parallel};
+  for (int p = 0; p < 2; ++p) {
+    S21ThreadPoolScope scope(*pools[p]);
+    results[p][0] = a * b;
+    results[p][1] = a + c * 2.0;
+    results[p][2] = a.Transpose();
+    results[p][3] = sq.InverseMatrix();
+    S21Matrix d(a);
+    d.SubMatrix(c);
+    d.MulNumber(3.0);
+    results[p][4] = d;
+  }
+  for (int r = 0; r < 5; ++r) EXPECT_TRUE(results[0][r] == results[1][r]);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
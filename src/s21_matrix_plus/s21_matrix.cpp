@@ -1,162 +1,366 @@
+#include <deque>
+#include <mutex>
+
+#include "s21_matrix_counters.h"
 #include "s21_matrix_exception.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_solve.h"
+#include "s21_matrix_strassen.h"
+#include "s21_thread_pool.h"
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix() : rows_(0), cols_(0) {}
+namespace {
+// Largest buffer a thread keeps between products: 32 MiB, a 2048 x 2048
+// double matrix. A larger product frees its buffer instead of pinning it
+// for the life of the thread.
+constexpr size_t kMaxLocalProductBytes = size_t(32) << 20;
+
+template <typename T>
+using Buffer = std::vector<T, S21AlignedAllocator<T>>;
+
+template <typename T>
+struct ProductStack {
+  std::deque<Buffer<T>> buffers;
+  size_t depth = 0;
+};
+
+// Buffer MulMatrix writes its product into before swapping it with the
+// operand, so in steady state it holds the previous operand's storage. It
+// outlives any resource scope, so it lives on the heap. A thread waiting
+// inside ParallelFor may run another MulMatrix, so the buffers of a thread
+// form a stack and a nested product takes the next one down.
+template <typename T>
+class LocalProduct {
+ public:
+  LocalProduct() : stack_(Stack()) {
+    if (stack_.buffers.size() <= stack_.depth)
+      stack_.buffers.emplace_back(S21AlignedAllocator<T>::Heap());
+    buffer_ = &stack_.buffers[stack_.depth++];
+  }
+  LocalProduct(const LocalProduct &) = delete;
+  LocalProduct &operator=(const LocalProduct &) = delete;
+  ~LocalProduct() {
+    if (buffer_->capacity() * sizeof(T) > kMaxLocalProductBytes)
+      Buffer<T>(buffer_->get_allocator()).swap(*buffer_);
+    --stack_.depth;
+  }
+  Buffer<T> &get() const { return *buffer_; }
+
+ private:
+  ProductStack<T> &stack_;
+  Buffer<T> *buffer_;
+
+  static ProductStack<T> &Stack() {
+    thread_local ProductStack<T> stack;
+    return stack;
+  }
+};
+
+// C = A * B with the algorithm MulMatrix was asked for.
+template <typename T>
+void Multiply(S21MulAlgorithm algorithm, int m, int n, int k, const T *a,
+              size_t lda, const T *b, size_t ldb, T *c, size_t ldc) {
+  if (algorithm == S21MulAlgorithm::kStrassen ||
+      (algorithm == S21MulAlgorithm::kAuto && s21::PreferStrassen(m, n, k)))
+    s21::StrassenGemm(m, n, k, a, lda, b, ldb, c, ldc);
+  else
+    s21::Gemm(m, n, k, T(1), a, lda, b, ldb, c, ldc);
+}
+
+// Side of the tiles the transpose recursion stops at: two 16 x 16 double
+// tiles take 4 KiB, well inside L1.
+constexpr int kTransposeLeaf = 16;
+// Rows of the source handed to one task by the parallel transpose.
+constexpr int kTransposeBand = 64;
+
+// dst (cols x rows) = transpose of src (rows x cols). The longer side is
+// halved until the block is a leaf tile, so at some level of the recursion
+// the tiles fit each cache level without knowing its size.
+template <typename T>
+void TransposeBlock(const T *src, size_t lds, T *dst, size_t ldd, int rows,
+                    int cols) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    for (int i = 0; i < rows; ++i)
+      for (int j = 0; j < cols; ++j) dst[j * ldd + i] = src[i * lds + j];
+  } else if (rows >= cols) {
+    int half = rows / 2;
+    TransposeBlock(src, lds, dst, ldd, half, cols);
+    TransposeBlock(src + half * lds, lds, dst + half, ldd, rows - half, cols);
+  } else {
+    int half = cols / 2;
+    TransposeBlock(src, lds, dst, ldd, rows, half);
+    TransposeBlock(src + half, lds, dst + half * ldd, ldd, rows, cols - half);
+  }
+}
+
+// Swaps x (rows x cols) with the transpose of y (cols x rows), both with
+// leading dimension ld, by the same recursion as TransposeBlock.
+template <typename T>
+void SwapTransposed(T *x, T *y, size_t ld, int rows, int cols) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    for (int i = 0; i < rows; ++i)
+      for (int j = 0; j < cols; ++j) std::swap(x[i * ld + j], y[j * ld + i]);
+  } else if (rows >= cols) {
+    int half = rows / 2;
+    SwapTransposed(x, y, ld, half, cols);
+    SwapTransposed(x + half * ld, y + half, ld, rows - half, cols);
+  } else {
+    int half = cols / 2;
+    SwapTransposed(x, y, ld, rows, half);
+    SwapTransposed(x + half, y + half * ld, ld, rows, cols - half);
+  }
+}
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+// In-place transpose of the n x n block at a: the diagonal blocks are
+// transposed recursively and the off-diagonal ones swapped transposed.
+template <typename T>
+void TransposeSquare(T *a, size_t ld, int n) {
+  if (n <= kTransposeLeaf) {
+    for (int i = 0; i < n; ++i)
+      for (int j = i + 1; j < n; ++j) std::swap(a[i * ld + j], a[j * ld + i]);
+    return;
+  }
+  int half = n / 2;
+  TransposeSquare(a, ld, half);
+  TransposeSquare(a + half * ld + half, ld, n - half);
+  SwapTransposed(a + half, a + half * ld, ld, half, n - half);
+}
+}  // namespace
+
+// Results derived from a matrix, each valid while the matrix is at the
+// version it was computed for. They are computed outside the lock, so
+// concurrent readers never wait for each other; two of them missing at
+// once may both compute the same result and the later one is kept.
+template <typename T>
+struct S21BasicMatrixCache {
+  using Real = typename S21BasicMatrix<T>::Real;
+  static constexpr uint64_t kNone = ~uint64_t(0);
+
+  std::mutex mutex;
+  uint64_t lu_version = kNone, inverse_version = kNone, norm_version = kNone;
+  std::shared_ptr<const S21BasicLUDecomposition<T>> lu;
+  // Null for a singular matrix.
+  std::shared_ptr<const S21BasicMatrix<T>> inverse;
+  Real rcond = 0, norm = 0;
+};
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(0), cols_(0), stride_(0), version_(0), cache_(nullptr) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      stride_(StrideFor(cols)),
+      version_(0),
+      cache_(nullptr) {
   if (rows <= 0 || cols <= 0)
     throw MatrixException("Constructor: Matrix cols/rows out of range");
-  matrix_.resize(rows_, std::vector<double>(cols_, 0.0));
+  matrix_.resize(static_cast<size_t>(rows_) * stride_, T(0));
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
-  isCorrect(*this);
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource *resource)
+    : rows_(rows),
+      cols_(cols),
+      stride_(StrideFor(cols)),
+      matrix_(S21AlignedAllocator<T>(resource)),
+      version_(0),
+      cache_(nullptr) {
+  if (rows <= 0 || cols <= 0)
+    throw MatrixException("Constructor: Matrix cols/rows out of range");
+  matrix_.resize(static_cast<size_t>(rows_) * stride_, T(0));
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other)
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
     : rows_(other.rows_),
       cols_(other.cols_),
-      matrix_(std::move(other.matrix_)) {
-  isCorrect(*this);
+      stride_(other.stride_),
+      matrix_(other.matrix_),
+      version_(0),
+      cache_(nullptr) {
+  S21_MATRIX_COPIED(matrix_.size() * sizeof(T));
+}
+
+// The cache moves along with the data it describes.
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      matrix_(std::move(other.matrix_)),
+      version_(other.get_version()),
+      cache_(other.cache_.exchange(nullptr)) {
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
+  ++other.version_;
+}
+
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
+  delete cache_.load();
 }
 
-S21Matrix::~S21Matrix() {}
+template <typename T>
+int S21BasicMatrix<T>::get_rows() const { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::get_cols() const { return cols_; }
 
-int S21Matrix::get_rows() const { return rows_; }
-int S21Matrix::get_cols() const { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::StrideFor(int cols) {
+  const int align = S21_MATRIX_ALIGNMENT / sizeof(T);
+  return (cols + align - 1) / align * align;
+}
 
-void S21Matrix::set_rows(int rows) {
+template <typename T>
+void S21BasicMatrix<T>::set_rows(int rows) {
   if (rows <= 0)
     throw MatrixException(
         "set_rows : Number of rows must be greater than zero.");
+  ++version_;
   rows_ = rows;
-  matrix_.resize(rows_);
-  for (auto &row : matrix_) {
-    row.resize(cols_, 0.0);
-  }
+  matrix_.resize(static_cast<size_t>(rows_) * stride_, T(0));
 }
 
-void S21Matrix::set_cols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::set_cols(int cols) {
   if (cols <= 0) {
     throw MatrixException(
         "set_cols: Number of columns must be greater than zero.");
   }
-  cols_ = cols;
-  for (auto &row : matrix_) {
-    row.resize(cols_, 0.0);
+  ++version_;
+  int stride = StrideFor(cols);
+  if (stride == stride_) {
+    // The new width fits into the existing row padding: only the cut off
+    // columns have to be cleared to keep the padding zeroed.
+    for (int i = 0; cols < cols_ && i < rows_; ++i)
+      std::fill(matrix_.data() + Offset(i, cols),
+                matrix_.data() + Offset(i, cols_), T(0));
+  } else {
+    std::vector<T, S21AlignedAllocator<T>> matrix(
+        static_cast<size_t>(rows_) * stride, T(0), matrix_.get_allocator());
+    int common = std::min(cols, cols_);
+    for (int i = 0; i < rows_; ++i)
+      std::copy(matrix_.data() + Offset(i, 0),
+                matrix_.data() + Offset(i, common),
+                matrix.data() + static_cast<size_t>(i) * stride);
+    matrix_.swap(matrix);
+    stride_ = stride;
   }
+  cols_ = cols;
 }
-void S21Matrix::set_element(int row, int col, double value) {
+template <typename T>
+void S21BasicMatrix<T>::set_element(int row, int col, T value) {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
     throw MatrixException("set_element: Index out of range");
   }
-  matrix_[row][col] = value;
+  ++version_;
+  matrix_[Offset(row, col)] = value;
 }
 
-double S21Matrix::get_element(int row, int col) const {
+template <typename T>
+T S21BasicMatrix<T>::get_element(int row, int col) const {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
     throw MatrixException("get_element: Index out of range");
   }
-  return matrix_[row][col];
-}
-
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
-  S21Matrix result(*this);
-  isCorrect(*this);
-  isCorrect(other);
-  result.SumMatrix(other);
-  return result;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
-  S21Matrix result(*this);
-  isCorrect(*this);
-  isCorrect(other);
-  result.SubMatrix(other);
-  return result;
+  return matrix_[Offset(row, col)];
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
-  S21Matrix result(*this);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix &other) const {
+  S21_MATRIX_PROBE(kMulMatrix, rows_, other.cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * other.cols_ * cols_);
   if (cols_ != other.rows_) {
     throw MatrixException(
         "Operator*: Matrices dimensions do not match for multiplication.");
   }
   isCorrect(*this);
   isCorrect(other);
-  result.MulMatrix(other);
+  S21BasicMatrix result(rows_, other.cols_);
+  Multiply(S21MulAlgorithm::kAuto, rows_, other.cols_, cols_, matrix_.data(),
+           stride_, other.matrix_.data(), other.stride_,
+           result.matrix_.data(), result.stride_);
   return result;
 }
 
-S21Matrix S21Matrix::operator*(double num) {
-  S21Matrix result(*this);
-  isCorrect(*this);
-  result.MulNumber(num);
-  return result;
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &other) {
+  return EqMatrix(other);
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) { return EqMatrix(other); }
-
-S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
-  isCorrect(other);
-  if (this != &other) {
+// Storage on another resource cannot be adopted, see S21AlignedAllocator,
+// so it is copied instead. The copy is made before anything else changes:
+// if it throws, both matrices are left as they were.
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(S21BasicMatrix &&other) {
+  if (this == &other) return *this;
+  if (matrix_.get_allocator() == other.matrix_.get_allocator()) {
+    matrix_ = std::move(other.matrix_);
     rows_ = other.rows_;
     cols_ = other.cols_;
-    matrix_ = std::move(other.matrix_);
-    other.rows_ = 0;
-    other.cols_ = 0;
+    stride_ = other.stride_;
+    ++version_;
+  } else {
+    *this = other;
+    std::vector<T, S21AlignedAllocator<T>>(other.matrix_.get_allocator())
+        .swap(other.matrix_);
   }
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  ++other.version_;
   return *this;
 }
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
-  isCorrect(other);
+// Copying into a vector that already has enough capacity reuses it, so
+// assigning between matrices of the same size does not allocate.
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
   if (this != &other) {
+    S21_MATRIX_COPIED(other.matrix_.size() * sizeof(T));
+    matrix_.assign(other.matrix_.begin(), other.matrix_.end());
+    ++version_;
     rows_ = other.rows_;
     cols_ = other.cols_;
-    matrix_ = other.matrix_;
+    stride_ = other.stride_;
   }
   return *this;
 }
 
-S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
-  isCorrect(*this);
-  isCorrect(other);
+// The compound operators leave validation to the operation they forward to.
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(const S21BasicMatrix &other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator-=(const S21Matrix &other) {
-  isCorrect(*this);
-  isCorrect(other);
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(const S21BasicMatrix &other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
-  isCorrect(*this);
-  isCorrect(other);
-  *this = *this * other;
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const S21BasicMatrix &other) {
+  MulMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(double num) {
-  isCorrect(*this);
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(T num) {
   MulNumber(num);
   return *this;
 }
 
-double &S21Matrix::operator()(int i, int j) {
-  isCorrect(*this);
-  if (i < 0 || i >= rows_ || j < 0 || j >= cols_)
-    throw MatrixException("Operator(): Index out of bounds.");
-
-  return matrix_[i][j];
-}
-
-void S21Matrix::isCorrect(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::isCorrect(const S21BasicMatrix &other) const {
+  S21_MATRIX_PROBE(kIsCorrect, other.rows_, other.cols_);
   if (other.matrix_.empty())
     throw MatrixException("isCorrect: Matrix is empty");
   if (other.rows_ < 0 || other.cols_ < 0)
@@ -164,160 +368,384 @@ void S21Matrix::isCorrect(const S21Matrix &other) {
         "isCorrect: Matrix is incorect. Problem with rows/cols");
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) {
+  S21_MATRIX_PROBE(kEqMatrix, rows_, cols_);
   bool result = true;
   isCorrect(*this);
   if (this == &other) {
   } else if ((rows_ != other.rows_ || cols_ != other.cols_)) {
     result = false;
-  } else
-    for (int i = 0; i < rows_ && result; ++i)
-      for (int j = 0; j < cols_ && result; ++j)
-        if (std::abs(matrix_[i][j] - other.matrix_[i][j]) > EPS) result = false;
+  } else {
+    result = s21::Simd<T>().equal(matrix_.data(), other.matrix_.data(),
+                                  matrix_.size(), kEpsilon);
+  }
 
   return result;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
+  S21_MATRIX_PROBE(kSumMatrix, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(rows_) * cols_);
   isCorrect(*this);
   if (rows_ != other.rows_ || cols_ != other.cols_)
     throw MatrixException(
         "SumMatrix: Matrices dimensions do not match for addition.");
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
-  }
+  ++version_;
+  // Equal shapes imply equal strides and zeroed padding, so the whole
+  // buffer can be processed as one flat array.
+  const T *src = other.matrix_.data();
+  T *dst = matrix_.data();
+  S21ThreadPool::ForRange(matrix_.size(), matrix_.size(),
+                          [=](int64_t begin, int64_t end) {
+                            s21::Simd<T>().add(dst + begin, src + begin,
+                                            end - begin);
+                          });
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
+  S21_MATRIX_PROBE(kSubMatrix, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(rows_) * cols_);
   isCorrect(*this);
   if (rows_ != other.rows_ || cols_ != other.cols_)
     throw MatrixException(
         "SubMatrix: Matrices dimensions do not match for subtraction.");
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
-  }
+  ++version_;
+  const T *src = other.matrix_.data();
+  T *dst = matrix_.data();
+  S21ThreadPool::ForRange(matrix_.size(), matrix_.size(),
+                          [=](int64_t begin, int64_t end) {
+                            s21::Simd<T>().sub(dst + begin, src + begin,
+                                            end - begin);
+                          });
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other,
+                                  S21MulAlgorithm algorithm) {
+  S21_MATRIX_PROBE(kMulMatrix, rows_, other.cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * other.cols_ * cols_);
   if (this->cols_ != other.rows_) {
     throw MatrixException(
         "MulMatrix: Matrices dimensions do not match for multiplication.");
   }
   isCorrect(*this);
-  S21Matrix result(this->rows_, other.cols_);
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      result.matrix_[i][j] = 0;
-      for (int k = 0; k < this->cols_; ++k) {
-        result.matrix_[i][j] += this->matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
+  // The product cannot overwrite an operand it is still reading, so it is
+  // formed in the scratch buffer, which then trades places with matrix_.
+  const int stride = StrideFor(other.cols_);
+  LocalProduct<T> local;
+  Buffer<T> &scratch = local.get();
+  scratch.resize(static_cast<size_t>(rows_) * stride);
+  T *product = scratch.data();
+  Multiply(algorithm, rows_, other.cols_, cols_, matrix_.data(), stride_,
+           other.matrix_.data(), other.stride_, product, stride);
+  for (int i = 0; stride > other.cols_ && i < rows_; ++i)
+    std::fill(product + static_cast<size_t>(i) * stride + other.cols_,
+              product + static_cast<size_t>(i + 1) * stride, T(0));
+  // Buffers of two resources cannot trade places; the product is copied
+  // into a matrix that lives on another one.
+  if (matrix_.get_allocator() == scratch.get_allocator()) {
+    matrix_.swap(scratch);
+  } else {
+    S21_MATRIX_COPIED(scratch.size() * sizeof(T));
+    matrix_.assign(scratch.begin(), scratch.end());
   }
-  *this = result;
+  cols_ = other.cols_;
+  stride_ = stride;
+  ++version_;
 }
 
-void S21Matrix::MulNumber(double num) {
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(T num) {
+  S21_MATRIX_PROBE(kMulNumber, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(rows_) * cols_);
   isCorrect(*this);
-  for (int i = 0; i < rows_; ++i)
-    for (int j = 0; j < cols_; ++j) matrix_[i][j] *= num;
+  ++version_;
+  T *dst = matrix_.data();
+  S21ThreadPool::ForRange(matrix_.size(), matrix_.size(),
+                          [=](int64_t begin, int64_t end) {
+                            s21::Simd<T>().scale(dst + begin, num, end - begin);
+                          });
 }
 
-void S21Matrix::Minor(S21Matrix &minor, int r, int c) {
+template <typename T>
+void S21BasicMatrix<T>::Axpy(T alpha, const S21BasicMatrix &other) {
+  S21_MATRIX_PROBE(kAxpy, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * cols_);
+  isCorrect(*this);
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw MatrixException(
+        "Axpy: Matrices dimensions do not match for addition.");
+  ++version_;
+  const T *src = other.matrix_.data();
+  T *dst = matrix_.data();
+  S21ThreadPool::ForRange(matrix_.size(), matrix_.size(),
+                          [=](int64_t begin, int64_t end) {
+                            s21::Simd<T>().axpy(dst + begin, alpha, src + begin,
+                                             end - begin);
+                          });
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Minor(S21BasicMatrix &minor, int r, int c) {
   isCorrect(*this);
   if (rows_ <= 1 || cols_ <= 1)
     throw MatrixException(
         "Minor: Matrix dimensions must be greater than 1 for minors.");
-  int m = rows_ - 1;
-  int n = cols_ - 1;
-  minor.set_rows(m);
-  minor.set_cols(n);
-  for (int i = 0, x = 0; i < m; i++, x++) {
-    if (x == r) x++;
-    for (int j = 0, y = 0; j < n; j++, y++) {
-      if (y == c) y++;
-      minor(i, j) = matrix_[x][y];
-    }
-  }
+  minor.set_rows(rows_ - 1);
+  minor.set_cols(cols_ - 1);
+  minor = MinorView(r, c);
 }
 
-double S21Matrix::Determinant() {
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
+  S21_MATRIX_PROBE(kDeterminant, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * rows_ * rows_ / 3);
   isCorrect(*this);
-  double result = 0.0;
+  T result = T(0);
   if (rows_ != cols_)
     throw MatrixException(
         "Determinant: Matrix must be square to compute determinant.");
   if (rows_ == 1) {
-    result = matrix_[0][0];
+    result = matrix_[0];
   } else if (rows_ == 2) {
-    result = matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+    result = matrix_[0] * matrix_[stride_ + 1] - matrix_[1] * matrix_[stride_];
   } else {
-    for (int i = 0; i < cols_; ++i) {
-      S21Matrix minor(rows_ - 1, cols_ - 1);
-      Minor(minor, 0, i);
-      result += matrix_[0][i] * minor.Determinant() * (i % 2 == 0 ? 1 : -1);
-    }
+    result = CachedLU()->Determinant();
   }
   return result;
 }
-S21Matrix S21Matrix::CalcComplements() {
+// Complements are the transposed adjugate, adj(A) = det(A) * A^-1, so a
+// nonsingular matrix gets them from one LU factorization. Only singular
+// matrices fall back to per-cell minors.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
+  S21_MATRIX_PROBE(kCalcComplements, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * rows_ * rows_ +
+                   uint64_t(rows_) * rows_);
   isCorrect(*this);
   if (rows_ != cols_) {
     throw MatrixException(
         "CalcComplements: Matrix must be square to compute complements.");
   }
-  S21Matrix result(rows_, cols_);
+  S21BasicMatrix result(rows_, cols_);
   if (rows_ == 1) {
     result(0, 0) = 1;
+    return result;
+  }
+  Real rcond = 0;
+  std::shared_ptr<const S21BasicMatrix> inverse = CachedInverse(&rcond);
+  if (inverse && rcond >= kMinRcond) {
+    T det = CachedLU()->Determinant();
+    for (int i = 0; i < rows_; ++i)
+      for (int j = 0; j < cols_; ++j)
+        result.matrix_[result.Offset(i, j)] =
+            det * inverse->matrix_[inverse->Offset(j, i)];
   } else {
+    S21BasicMatrix minor(rows_ - 1, cols_ - 1);
     for (int i = 0; i < rows_; ++i) {
       for (int j = 0; j < cols_; ++j) {
-        S21Matrix minor(rows_ - 1, cols_ - 1);
         Minor(minor, i, j);
-        double det = minor.Determinant();
-        result(i, j) = std::pow(-1, i + j) * det;
+        result.matrix_[result.Offset(i, j)] =
+            T((i + j) % 2 ? -1 : 1) * minor.Determinant();
       }
     }
   }
   return result;
 }
-S21Matrix S21Matrix::Transpose() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
+  S21_MATRIX_PROBE(kTranspose, rows_, cols_);
   isCorrect(*this);
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result(j, i) = matrix_[i][j];
-    }
-  }
+  S21BasicMatrix result(cols_, rows_);
+  // Bands of source rows become disjoint bands of result columns.
+  const int bands = (rows_ + kTransposeBand - 1) / kTransposeBand;
+  S21ThreadPool::ForRange(
+      bands, matrix_.size(), [&](int64_t begin, int64_t end) {
+        int first = static_cast<int>(begin) * kTransposeBand;
+        int last = std::min(rows_, static_cast<int>(end) * kTransposeBand);
+        TransposeBlock(matrix_.data() + Offset(first, 0), stride_,
+                       result.matrix_.data() + first, result.stride_,
+                       last - first, cols_);
+      });
   return result;
 }
-S21Matrix S21Matrix::InverseMatrix() {
+
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  isCorrect(*this);
+  if (rows_ != cols_)
+    throw MatrixException("TransposeInPlace: Matrix must be square.");
+  ++version_;
+  TransposeSquare(matrix_.data(), stride_, rows_);
+}
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  S21_MATRIX_PROBE(kInverseMatrix, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * rows_ * rows_);
   isCorrect(*this);
   if (rows_ != cols_) {
     throw MatrixException(
         "InverseMatrix: Matrix must be square to compute the inverse.");
   }
-  double det = Determinant();
-  if (fabs(det) < 1e-7) {
+  Real rcond = 0;
+  std::shared_ptr<const S21BasicMatrix> inverse = CachedInverse(&rcond);
+  if (!inverse) {
     throw MatrixException(
         "InverseMatrix: Matrix determinant is 0, the matrix is not "
         "invertible.");
   }
-  S21Matrix complements = CalcComplements();
-  S21Matrix transposed = complements.Transpose();
-  S21Matrix inverse = transposed * (1.0 / det);
+  if (rcond < kMinRcond) {
+    throw MatrixException(
+        "InverseMatrix: Matrix is too ill-conditioned to be inverted.");
+  }
+  return S21BasicMatrix(*inverse);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const S21BasicMatrix &b,
+                                           S21SolveHint hint) const {
+  S21_MATRIX_PROBE(kSolve, rows_, cols_);
+  S21_MATRIX_FLOPS(uint64_t(2) * rows_ * rows_ * rows_ / 3 +
+                   uint64_t(2) * rows_ * rows_ * b.cols_);
+  isCorrect(*this);
+  isCorrect(b);
+  if (rows_ != cols_)
+    throw MatrixException("Solve: Matrix must be square to solve a system.");
+  return S21BasicLinearSolver<T>(*this, hint).Solve(b);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LeastSquares(
+    const S21BasicMatrix &b) const {
+  S21_MATRIX_PROBE(kLeastSquares, rows_, cols_);
+  // Householder QR, then Q^T * b and the triangular solve. A matrix with
+  // fewer rows than columns is rejected, but still counted: max() keeps
+  // the difference from wrapping around.
+  S21_MATRIX_FLOPS(uint64_t(2) * cols_ * cols_ * std::max(rows_, cols_) -
+                   uint64_t(2) * cols_ * cols_ * cols_ / 3 +
+                   uint64_t(4) * rows_ * cols_ * b.cols_);
+  isCorrect(*this);
+  isCorrect(b);
+  return S21BasicQRDecomposition<T>(*this).Solve(b);
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::Real S21BasicMatrix<T>::NormOne() const {
+  // Only a matrix something else was cached for keeps its norm: creating
+  // the cache would cost more than the norm for a one-off call.
+  S21BasicMatrixCache<T> *cache = cache_.load(std::memory_order_acquire);
+  if (cache) {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (cache->norm_version == version_) return cache->norm;
+  }
+  Real result = 0;
+  std::vector<Real> sums(cols_, 0);
+  for (int i = 0; i < rows_; ++i) {
+    const T *row = matrix_.data() + Offset(i, 0);
+    for (int j = 0; j < cols_; ++j) sums[j] += std::abs(row[j]);
+  }
+  for (Real sum : sums) result = std::max(result, sum);
+  if (cache) {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    cache->norm = result;
+    cache->norm_version = version_;
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixCache<T> &S21BasicMatrix<T>::GetCache() const {
+  S21BasicMatrixCache<T> *cache = cache_.load(std::memory_order_acquire);
+  if (!cache) {
+    auto created = std::make_unique<S21BasicMatrixCache<T>>();
+    if (cache_.compare_exchange_strong(cache, created.get(),
+                                       std::memory_order_acq_rel))
+      cache = created.release();
+  }
+  return *cache;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ReleaseCache() const {
+  S21BasicMatrixCache<T> *cache = cache_.load(std::memory_order_acquire);
+  if (!cache) return;
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  cache->lu_version = cache->inverse_version = cache->norm_version =
+      S21BasicMatrixCache<T>::kNone;
+  cache->lu.reset();
+  cache->inverse.reset();
+}
+
+// The cached matrices are allocated from the matrix's own resource, which
+// outlives them, rather than from whatever scope the caller is in.
+template <typename T>
+std::shared_ptr<const S21BasicLUDecomposition<T>> S21BasicMatrix<T>::CachedLU()
+    const {
+  S21BasicMatrixCache<T> &cache = GetCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.lu_version == version_) return cache.lu;
+  }
+  std::shared_ptr<const S21BasicLUDecomposition<T>> lu;
+  {
+    S21MatrixResourceScope scope(get_resource());
+    lu = std::make_shared<const S21BasicLUDecomposition<T>>(*this);
+  }
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.lu = lu;
+  cache.lu_version = version_;
+  return lu;
+}
+
+template <typename T>
+std::shared_ptr<const S21BasicMatrix<T>> S21BasicMatrix<T>::CachedInverse(
+    Real *rcond) const {
+  S21BasicMatrixCache<T> &cache = GetCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.inverse_version == version_) {
+      *rcond = cache.rcond;
+      return cache.inverse;
+    }
+  }
+  std::shared_ptr<const S21BasicLUDecomposition<T>> lu = CachedLU();
+  std::shared_ptr<const S21BasicMatrix> inverse;
+  *rcond = 0;
+  if (!lu->IsSingular()) {
+    S21MatrixResourceScope scope(get_resource());
+    inverse = std::make_shared<const S21BasicMatrix>(lu->Inverse());
+    *rcond = ReciprocalCondition(*inverse);
+  }
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.inverse = inverse;
+  cache.rcond = *rcond;
+  cache.inverse_version = version_;
   return inverse;
 }
 
-// void S21Matrix::print() const {
+// 1 / (||A||_1 * ||A^-1||_1): close to 1 for well conditioned matrices and
+// near machine epsilon when the inverse is dominated by rounding errors.
+template <typename T>
+typename S21BasicMatrix<T>::Real S21BasicMatrix<T>::ReciprocalCondition(
+    const S21BasicMatrix &inverse) const {
+  Real norm = NormOne() * inverse.NormOne();
+  return norm > 0 && std::isfinite(norm) ? 1 / norm : 0;
+}
+
+// void S21BasicMatrix<T>::print() const {
 //   for (int i = 0; i < rows_; ++i) {
 //     for (int j = 0; j < cols_; ++j) {
-//       std::cout << matrix_[i][j] << " ";
+//       std::cout << matrix_[Offset(i, j)] << " ";
 //     }
 //     std::cout << std::endl;
 //   }
-// }
\ No newline at end of file
+// }
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<std::complex<double>>;
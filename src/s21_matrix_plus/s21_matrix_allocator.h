@@ -0,0 +1,72 @@
+#ifndef S21_MATRIX_ALLOCATOR
+#define S21_MATRIX_ALLOCATOR
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include "s21_matrix_counters.h"
+#include "s21_matrix_resource.h"
+
+// Alignment of every matrix buffer and of every row start inside it.
+#define S21_MATRIX_ALIGNMENT 64
+
+// Allocator handing out S21_MATRIX_ALIGNMENT-aligned blocks, so that the
+// flat matrix storage starts on a cache line boundary. The blocks come from
+// a std::pmr::memory_resource: by default the one of the innermost
+// S21MatrixResourceScope at construction. As with std::pmr containers a
+// container keeps its resource for life: a copy takes the current resource
+// again, and assignment, including move assignment, never hands a
+// container's storage to another resource.
+template <typename T>
+class S21AlignedAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+  S21AlignedAllocator() noexcept
+      : resource_(S21MatrixResourceScope::Current()) {}
+  explicit S21AlignedAllocator(std::pmr::memory_resource *resource) noexcept
+      : resource_(resource) {}
+  template <typename U>
+  S21AlignedAllocator(const S21AlignedAllocator<U> &other) noexcept
+      : resource_(other.resource()) {}
+
+  // Plain heap storage whatever scope is active, for buffers that outlive
+  // the scope they are created in.
+  static S21AlignedAllocator Heap() noexcept {
+    return S21AlignedAllocator(std::pmr::new_delete_resource());
+  }
+
+  std::pmr::memory_resource *resource() const noexcept { return resource_; }
+  S21AlignedAllocator select_on_container_copy_construction() const {
+    return S21AlignedAllocator();
+  }
+
+  T *allocate(std::size_t n) {
+    S21_MATRIX_ALLOCATED(n * sizeof(T));
+    return static_cast<T *>(
+        resource_->allocate(n * sizeof(T), S21_MATRIX_ALIGNMENT));
+  }
+  void deallocate(T *p, std::size_t n) noexcept {
+    resource_->deallocate(p, n * sizeof(T), S21_MATRIX_ALIGNMENT);
+  }
+
+  template <typename U>
+  bool operator==(const S21AlignedAllocator<U> &other) const noexcept {
+    return resource_ == other.resource() ||
+           resource_->is_equal(*other.resource());
+  }
+  template <typename U>
+  bool operator!=(const S21AlignedAllocator<U> &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  std::pmr::memory_resource *resource_;
+};
+
+#endif  // S21_MATRIX_ALLOCATOR
@@ -0,0 +1,282 @@
+#include "s21_matrix_async.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace async {
+
+template <typename T>
+struct Node {
+  enum class Kind { kInput, kLinear, kMul, kTranspose, kInverse };
+
+  Kind kind;
+  int rows, cols;
+  // Cleared once the node is computed, releasing the inputs.
+  std::vector<std::shared_ptr<Node>> inputs;
+  // kLinear: value = sum of coefficients[i] * inputs[i].
+  std::vector<T> coefficients;
+  S21BasicMatrix<T> value;
+  bool done = false;
+};
+
+namespace {
+
+// Elements per pass of a linear combination: every term of a chunk is
+// added while the chunk of the result is still in L1.
+constexpr size_t kLinearChunk = 2048;
+
+template <typename T>
+using NodePtr = std::shared_ptr<Node<T>>;
+
+template <typename T>
+NodePtr<T> MakeNode(typename Node<T>::Kind kind, int rows, int cols,
+                    std::vector<NodePtr<T>> inputs,
+                    std::vector<T> coefficients = {}) {
+  auto node = std::make_shared<Node<T>>();
+  node->kind = kind;
+  node->rows = rows;
+  node->cols = cols;
+  node->inputs = std::move(inputs);
+  node->coefficients = std::move(coefficients);
+  return node;
+}
+
+// Splices pending linear inputs that only this node refers to into its own
+// terms, so the whole chain is evaluated in one pass without temporaries.
+template <typename T>
+void Fuse(Node<T> &node) {
+  if (node.kind != Node<T>::Kind::kLinear) return;
+  for (size_t i = 0; i < node.inputs.size();) {
+    NodePtr<T> input = node.inputs[i];
+    if (input->kind != Node<T>::Kind::kLinear || input->done ||
+        input.use_count() != 2) {
+      ++i;
+      continue;
+    }
+    const T scale = node.coefficients[i];
+    node.inputs.erase(node.inputs.begin() + i);
+    node.coefficients.erase(node.coefficients.begin() + i);
+    for (size_t j = 0; j < input->inputs.size(); ++j) {
+      node.inputs.push_back(input->inputs[j]);
+      node.coefficients.push_back(scale * input->coefficients[j]);
+    }
+  }
+}
+
+template <typename T>
+void Combine(Node<T> &node) {
+  node.value = S21BasicMatrix<T>(node.rows, node.cols);
+  const size_t size =
+      static_cast<size_t>(node.rows) * node.value.get_stride();
+  const size_t chunks = (size + kLinearChunk - 1) / kLinearChunk;
+  T *dst = node.value.data();
+  std::vector<const T *> terms;
+  for (const NodePtr<T> &input : node.inputs)
+    terms.push_back(std::as_const(input->value).data());
+  S21ThreadPool::ForRange(
+      chunks, size * terms.size(), [&](int64_t begin, int64_t end) {
+        const auto &simd = s21::Simd<T>();
+        for (int64_t c = begin; c < end; ++c) {
+          const size_t first = c * kLinearChunk;
+          const size_t count = std::min(kLinearChunk, size - first);
+          for (size_t i = 0; i < terms.size(); ++i)
+            simd.axpy(dst + first, node.coefficients[i], terms[i] + first,
+                      count);
+        }
+      });
+}
+
+template <typename T>
+void Compute(Node<T> &node) {
+  using Kind = typename Node<T>::Kind;
+  switch (node.kind) {
+    case Kind::kInput:
+      break;
+    case Kind::kLinear:
+      Combine(node);
+      break;
+    case Kind::kMul:
+      node.value = node.inputs[0]->value * node.inputs[1]->value;
+      break;
+    case Kind::kTranspose:
+      node.value = node.inputs[0]->value.Transpose();
+      break;
+    case Kind::kInverse:
+      node.value = node.inputs[0]->value.InverseMatrix();
+      break;
+  }
+  node.inputs.clear();
+  node.coefficients.clear();
+  node.done = true;
+}
+
+// The pending nodes reachable from the roots, with their edges.
+template <typename T>
+class Graph {
+ public:
+  explicit Graph(const std::vector<NodePtr<T>> &roots) {
+    std::unordered_map<Node<T> *, int> index;
+    std::vector<Node<T> *> stack;
+    for (const NodePtr<T> &root : roots) stack.push_back(root.get());
+    while (!stack.empty()) {
+      Node<T> *node = stack.back();
+      stack.pop_back();
+      if (node->done || index.count(node)) continue;
+      Fuse(*node);
+      index.emplace(node, static_cast<int>(nodes_.size()));
+      nodes_.push_back(node);
+      for (const NodePtr<T> &input : node->inputs)
+        if (!input->done) stack.push_back(input.get());
+    }
+    pending_ = std::make_unique<std::atomic<int>[]>(nodes_.size());
+    consumers_.resize(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+      int inputs = 0;
+      for (const NodePtr<T> &input : nodes_[i]->inputs) {
+        if (input->done) continue;
+        consumers_[index.at(input.get())].push_back(static_cast<int>(i));
+        ++inputs;
+      }
+      pending_[i].store(inputs, std::memory_order_relaxed);
+      if (inputs == 0) ready_.push_back(static_cast<int>(i));
+    }
+  }
+
+  void Run() { Execute(std::move(ready_)); }
+
+ private:
+  std::vector<Node<T> *> nodes_;
+  std::unique_ptr<std::atomic<int>[]> pending_;
+  std::vector<std::vector<int>> consumers_;
+  std::vector<int> ready_;
+
+  // Computes node i and returns the consumers it was the last input of.
+  std::vector<int> Complete(int i) {
+    Compute(*nodes_[i]);
+    std::vector<int> ready;
+    for (int consumer : consumers_[i])
+      if (pending_[consumer].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        ready.push_back(consumer);
+    return ready;
+  }
+
+  // Runs the ready nodes as pool tasks and, recursively, whatever each of
+  // them makes ready. The pool's ParallelFor keeps its caller executing
+  // queued tasks while it waits, so nothing blocks a worker. A single
+  // successor runs in the same frame, keeping chains off the stack.
+  void Execute(std::vector<int> ready) {
+    while (ready.size() == 1) ready = Complete(ready[0]);
+    if (ready.empty()) return;
+    S21ThreadPool::Current().ParallelFor(
+        ready.size(), 1, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) Execute(Complete(ready[i]));
+        });
+  }
+};
+
+}  // namespace
+
+template <typename T>
+Future<T>::Future(std::shared_ptr<Node<T>> node) : node_(std::move(node)) {}
+
+template <typename T>
+Future<T>::Future(const S21BasicMatrix<T> &matrix)
+    : Future(S21BasicMatrix<T>(matrix)) {}
+
+template <typename T>
+Future<T>::Future(S21BasicMatrix<T> &&matrix) {
+  matrix.isCorrect(matrix);
+  node_ = MakeNode<T>(Node<T>::Kind::kInput, matrix.get_rows(),
+                      matrix.get_cols(), {});
+  node_->value = std::move(matrix);
+  node_->done = true;
+}
+
+template <typename T>
+int Future<T>::get_rows() const {
+  return node_->rows;
+}
+
+template <typename T>
+int Future<T>::get_cols() const {
+  return node_->cols;
+}
+
+template <typename T>
+bool Future<T>::ready() const {
+  return node_->done;
+}
+
+template <typename T>
+const S21BasicMatrix<T> &Future<T>::get() const {
+  if (!node_->done) Run({*this});
+  return node_->value;
+}
+
+template <typename T>
+Future<T> Future<T>::Sum(const Future &a, const Future &b) {
+  if (a.get_rows() != b.get_rows() || a.get_cols() != b.get_cols())
+    throw MatrixException(S21AddOp::kMismatch);
+  return Future(MakeNode<T>(Node<T>::Kind::kLinear, a.get_rows(),
+                            a.get_cols(), {a.node_, b.node_}, {T(1), T(1)}));
+}
+
+template <typename T>
+Future<T> Future<T>::Sub(const Future &a, const Future &b) {
+  if (a.get_rows() != b.get_rows() || a.get_cols() != b.get_cols())
+    throw MatrixException(S21SubOp::kMismatch);
+  return Future(MakeNode<T>(Node<T>::Kind::kLinear, a.get_rows(),
+                            a.get_cols(), {a.node_, b.node_}, {T(1), T(-1)}));
+}
+
+template <typename T>
+Future<T> Future<T>::Scale(const Future &a, T num) {
+  return Future(MakeNode<T>(Node<T>::Kind::kLinear, a.get_rows(),
+                            a.get_cols(), {a.node_}, {num}));
+}
+
+template <typename T>
+Future<T> Future<T>::Mul(const Future &a, const Future &b) {
+  if (a.get_cols() != b.get_rows())
+    throw MatrixException(
+        "MulMatrix: Matrices dimensions do not match for multiplication.");
+  return Future(MakeNode<T>(Node<T>::Kind::kMul, a.get_rows(), b.get_cols(),
+                            {a.node_, b.node_}));
+}
+
+template <typename T>
+Future<T> Future<T>::Transpose(const Future &a) {
+  return Future(MakeNode<T>(Node<T>::Kind::kTranspose, a.get_cols(),
+                            a.get_rows(), {a.node_}));
+}
+
+template <typename T>
+Future<T> Future<T>::Inverse(const Future &a) {
+  if (a.get_rows() != a.get_cols())
+    throw MatrixException(
+        "InverseMatrix: Matrix must be square to compute the inverse.");
+  return Future(MakeNode<T>(Node<T>::Kind::kInverse, a.get_rows(),
+                            a.get_cols(), {a.node_}));
+}
+
+template <typename T>
+void Future<T>::Run(const std::vector<Future> &futures) {
+  std::vector<NodePtr<T>> roots;
+  for (const Future &future : futures) roots.push_back(future.node_);
+  Graph<T>(roots).Run();
+}
+
+template class Future<float>;
+template class Future<double>;
+template class Future<long double>;
+template class Future<std::complex<double>>;
+
+}  // namespace async
+}  // namespace s21
@@ -0,0 +1,120 @@
+#ifndef S21_MATRIX_ASYNC
+#define S21_MATRIX_ASYNC
+
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+namespace async {
+
+template <typename T>
+struct Node;
+
+// Lazily evaluated matrix: a node of a graph of operations, built by the
+// functions below without computing anything. get() or Run() evaluates
+// what the requested nodes still need:
+//
+//   auto x = async::Mul(a, b), y = async::Inverse(c);
+//   auto z = async::Sum(async::Scale(x, 2.0), async::Transpose(y));
+//   const S21Matrix &result = z.get();
+//
+// The scheduler runs every node whose inputs are ready as a task on the
+// current S21ThreadPool, so independent branches (x and y above) proceed
+// concurrently, and each operation parallelizes internally as usual.
+// Chains of Sum, Sub and Scale collapse into one linear combination
+// evaluated in a single pass, unless some Future still refers to an inner
+// node. A node drops its inputs once computed, so an intermediate nobody
+// else holds is freed as soon as its last consumer finishes.
+//
+// Shapes are checked when a node is built, errors of the computation
+// itself (a singular Inverse) are thrown by get() or Run(). Futures are
+// cheap handles sharing their node; a graph must not be evaluated from
+// two threads at once.
+template <typename T>
+class Future {
+ public:
+  using value_type = T;
+
+  // Input node holding a copy of `matrix`, or the matrix itself when it
+  // is moved in, so later changes to the argument do not affect it.
+  Future(const S21BasicMatrix<T> &matrix);
+  Future(S21BasicMatrix<T> &&matrix);
+
+  int get_rows() const;
+  int get_cols() const;
+  bool ready() const;
+  // Evaluates this node if needed and returns its value.
+  const S21BasicMatrix<T> &get() const;
+
+  static Future Sum(const Future &a, const Future &b);
+  static Future Sub(const Future &a, const Future &b);
+  static Future Scale(const Future &a, T num);
+  static Future Mul(const Future &a, const Future &b);
+  static Future Transpose(const Future &a);
+  static Future Inverse(const Future &a);
+
+  // Evaluates several nodes together: shared inputs are computed once and
+  // independent ones concurrently.
+  static void Run(const std::vector<Future> &futures);
+
+ private:
+  std::shared_ptr<Node<T>> node_;
+
+  explicit Future(std::shared_ptr<Node<T>> node);
+};
+
+// Element type of a Future or matrix operand.
+template <typename A>
+using ValueOf = typename std::decay_t<A>::value_type;
+
+// Operands may be Futures or matrices; a matrix becomes an input node.
+template <typename A, typename B>
+Future<ValueOf<A>> Sum(A &&a, B &&b) {
+  return Future<ValueOf<A>>::Sum(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A, typename B>
+Future<ValueOf<A>> Sub(A &&a, B &&b) {
+  return Future<ValueOf<A>>::Sub(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A, typename S>
+Future<ValueOf<A>> Scale(A &&a, S num) {
+  return Future<ValueOf<A>>::Scale(std::forward<A>(a),
+                                   static_cast<ValueOf<A>>(num));
+}
+
+template <typename A, typename B>
+Future<ValueOf<A>> Mul(A &&a, B &&b) {
+  return Future<ValueOf<A>>::Mul(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A>
+Future<ValueOf<A>> Transpose(A &&a) {
+  return Future<ValueOf<A>>::Transpose(std::forward<A>(a));
+}
+
+template <typename A>
+Future<ValueOf<A>> Inverse(A &&a) {
+  return Future<ValueOf<A>>::Inverse(std::forward<A>(a));
+}
+
+template <typename T>
+void Run(std::initializer_list<Future<T>> futures) {
+  Future<T>::Run(futures);
+}
+
+extern template class Future<float>;
+extern template class Future<double>;
+extern template class Future<long double>;
+extern template class Future<std::complex<double>>;
+
+}  // namespace async
+}  // namespace s21
+
+#endif  // S21_MATRIX_ASYNC
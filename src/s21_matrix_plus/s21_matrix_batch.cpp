@@ -0,0 +1,399 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Lane arrays of the elements of a square matrix, row-major: e[i * n + j]
+// points at the batch values of element (i, j).
+template <typename T>
+struct Lanes {
+  const T *e[16];
+};
+
+template <typename T>
+struct MutableLanes {
+  T *e[16];
+};
+
+// Closed-form determinants, lane by lane over [begin, end). The bodies are
+// branch-free so the loops vectorize.
+template <int N, typename T>
+void DeterminantLanes(const Lanes<T> &a, T *det, int64_t begin,
+                      int64_t end) {
+  const T *const *e = a.e;
+  for (int64_t b = begin; b < end; ++b) {
+    auto m = [&](int i, int j) { return e[i * N + j][b]; };
+    if constexpr (N == 1) {
+      det[b] = m(0, 0);
+    } else if constexpr (N == 2) {
+      det[b] = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    } else if constexpr (N == 3) {
+      det[b] = m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) +
+               m(0, 1) * (m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2)) +
+               m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+    } else {
+      T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+      T s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+      T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+      T s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+      T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+      T s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+      T c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+      T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+      T c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+      T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+      T c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+      T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+      det[b] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+  }
+}
+
+// Adjugate over determinant, lane by lane; det receives the determinants
+// so the caller can reject singular matrices afterwards.
+template <int N, typename T>
+void InverseLanes(const Lanes<T> &a, const MutableLanes<T> &out, T *det,
+                  int64_t begin, int64_t end) {
+  const T *const *e = a.e;
+  T *const *o = out.e;
+  for (int64_t b = begin; b < end; ++b) {
+    auto m = [&](int i, int j) { return e[i * N + j][b]; };
+    auto r = [&](int i, int j) -> T & { return o[i * N + j][b]; };
+    if constexpr (N == 1) {
+      det[b] = m(0, 0);
+      r(0, 0) = T(1) / m(0, 0);
+    } else if constexpr (N == 2) {
+      T d = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+      T inv = T(1) / d;
+      det[b] = d;
+      r(0, 0) = m(1, 1) * inv;
+      r(0, 1) = -m(0, 1) * inv;
+      r(1, 0) = -m(1, 0) * inv;
+      r(1, 1) = m(0, 0) * inv;
+    } else if constexpr (N == 3) {
+      T c00 = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+      T c10 = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+      T c20 = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+      T d = m(0, 0) * c00 + m(0, 1) * c10 + m(0, 2) * c20;
+      T inv = T(1) / d;
+      det[b] = d;
+      r(0, 0) = c00 * inv;
+      r(0, 1) = (m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2)) * inv;
+      r(0, 2) = (m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1)) * inv;
+      r(1, 0) = c10 * inv;
+      r(1, 1) = (m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0)) * inv;
+      r(1, 2) = (m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2)) * inv;
+      r(2, 0) = c20 * inv;
+      r(2, 1) = (m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1)) * inv;
+      r(2, 2) = (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * inv;
+    } else {
+      T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+      T s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+      T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+      T s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+      T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+      T s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+      T c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+      T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+      T c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+      T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+      T c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+      T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+      T d = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+      T inv = T(1) / d;
+      det[b] = d;
+      r(0, 0) = (m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3) * inv;
+      r(0, 1) = (-m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3) * inv;
+      r(0, 2) = (m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3) * inv;
+      r(0, 3) = (-m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3) * inv;
+      r(1, 0) = (-m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1) * inv;
+      r(1, 1) = (m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1) * inv;
+      r(1, 2) = (-m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1) * inv;
+      r(1, 3) = (m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1) * inv;
+      r(2, 0) = (m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0) * inv;
+      r(2, 1) = (-m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0) * inv;
+      r(2, 2) = (m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0) * inv;
+      r(2, 3) = (-m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0) * inv;
+      r(3, 0) = (-m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0) * inv;
+      r(3, 1) = (m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0) * inv;
+      r(3, 2) = (-m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0) * inv;
+      r(3, 3) = (m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0) * inv;
+    }
+  }
+}
+
+// Gauss-Jordan elimination with partial pivoting on one n x n matrix in
+// `a`, turning `inverse` (identity on entry, or null) into its inverse.
+// Returns the determinant; zero leaves `inverse` unfinished.
+template <typename T>
+T Eliminate(T *a, T *inverse, int n) {
+  T det = T(1);
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i)
+      if (std::abs(a[i * n + k]) > std::abs(a[pivot * n + k])) pivot = i;
+    if (a[pivot * n + k] == T(0)) return T(0);
+    if (pivot != k) {
+      det = -det;
+      for (int j = 0; j < n; ++j) {
+        std::swap(a[k * n + j], a[pivot * n + j]);
+        if (inverse) std::swap(inverse[k * n + j], inverse[pivot * n + j]);
+      }
+    }
+    det *= a[k * n + k];
+    T scale = T(1) / a[k * n + k];
+    for (int j = 0; j < n; ++j) {
+      a[k * n + j] *= scale;
+      if (inverse) inverse[k * n + j] *= scale;
+    }
+    for (int i = inverse ? 0 : k + 1; i < n; ++i) {
+      if (i == k) continue;
+      T l = a[i * n + k];
+      for (int j = 0; j < n; ++j) {
+        a[i * n + j] -= l * a[k * n + j];
+        if (inverse) inverse[i * n + j] -= l * inverse[k * n + j];
+      }
+    }
+  }
+  return det;
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch()
+    : count_(0), rows_(0), cols_(0), lane_stride_(0) {}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols)
+    : count_(count),
+      rows_(rows),
+      cols_(cols),
+      lane_stride_(LaneStrideFor(count)) {
+  if (count <= 0 || rows <= 0 || cols <= 0)
+    throw MatrixException("MatrixBatch: Batch count/rows/cols out of range");
+  data_.resize(static_cast<size_t>(rows) * cols * lane_stride_, T(0));
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::LaneStrideFor(int count) {
+  const int align = S21_MATRIX_ALIGNMENT / sizeof(T);
+  return (count + align - 1) / align * align;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::get_count() const {
+  return count_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::get_rows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::get_cols() const {
+  return cols_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::get_lane_stride() const {
+  return lane_stride_;
+}
+
+template <typename T>
+T *S21BasicMatrixBatch<T>::lanes(int row, int col) {
+  return data_.data() + (static_cast<size_t>(row) * cols_ + col) * lane_stride_;
+}
+
+template <typename T>
+const T *S21BasicMatrixBatch<T>::lanes(int row, int col) const {
+  return data_.data() + (static_cast<size_t>(row) * cols_ + col) * lane_stride_;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::CheckIndex(int index) const {
+  if (index < 0 || index >= count_)
+    throw MatrixException("MatrixBatch: Batch index out of bounds.");
+}
+
+template <typename T>
+T &S21BasicMatrixBatch<T>::operator()(int index, int row, int col) {
+  CheckIndex(index);
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("Operator(): Index out of bounds.");
+  return lanes(row, col)[index];
+}
+
+template <typename T>
+T S21BasicMatrixBatch<T>::operator()(int index, int row, int col) const {
+  CheckIndex(index);
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("Operator(): Index out of bounds.");
+  return lanes(row, col)[index];
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T> &matrix) {
+  CheckIndex(index);
+  if (matrix.get_rows() != rows_ || matrix.get_cols() != cols_)
+    throw MatrixException("Set: Matrix dimensions do not match the batch.");
+  for (int i = 0; i < rows_; ++i)
+    for (int j = 0; j < cols_; ++j) lanes(i, j)[index] = matrix.row(i)[j];
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  CheckIndex(index);
+  S21BasicMatrix<T> result(rows_, cols_);
+  for (int i = 0; i < rows_; ++i)
+    for (int j = 0; j < cols_; ++j) result.row(i)[j] = lanes(i, j)[index];
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::SumMatrix(
+    const S21BasicMatrixBatch &other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ || cols_ != other.cols_)
+    throw MatrixException(S21AddOp::kMismatch);
+  S21BasicMatrixBatch result(*this);
+  T *dst = result.data_.data();
+  const T *src = other.data_.data();
+  S21ThreadPool::ForRange(data_.size(), data_.size(),
+                          [=](int64_t begin, int64_t end) {
+                            s21::Simd<T>().add(dst + begin, src + begin,
+                                               end - begin);
+                          });
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::MulMatrix(
+    const S21BasicMatrixBatch &other) const {
+  if (count_ != other.count_ || cols_ != other.rows_)
+    throw MatrixException(
+        "MulMatrix: Matrices dimensions do not match for multiplication.");
+  S21BasicMatrixBatch result(count_, rows_, other.cols_);
+  S21ThreadPool::ForRange(
+      count_, static_cast<size_t>(count_) * rows_ * cols_ * other.cols_,
+      [&](int64_t begin, int64_t end) {
+        for (int i = 0; i < rows_; ++i) {
+          for (int j = 0; j < other.cols_; ++j) {
+            T *c = result.lanes(i, j);
+            for (int k = 0; k < cols_; ++k) {
+              const T *x = lanes(i, k), *y = other.lanes(k, j);
+              for (int64_t b = begin; b < end; ++b) c[b] += x[b] * y[b];
+            }
+          }
+        }
+      });
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::Transpose() const {
+  S21BasicMatrixBatch result(count_, cols_, rows_);
+  for (int i = 0; i < rows_; ++i)
+    for (int j = 0; j < cols_; ++j)
+      std::copy(lanes(i, j), lanes(i, j) + lane_stride_, result.lanes(j, i));
+  return result;
+}
+
+template <typename T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  if (rows_ != cols_)
+    throw MatrixException(
+        "Determinant: Matrix must be square to compute determinant.");
+  const int n = rows_;
+  std::vector<T> det(count_);
+  Lanes<T> a = {};
+  for (int k = 0; n <= 4 && k < n * n; ++k) a.e[k] = lanes(k / n, k % n);
+  S21ThreadPool::ForRange(
+      count_, static_cast<size_t>(count_) * n * n * n,
+      [&](int64_t begin, int64_t end) {
+        switch (n) {
+          case 1:
+            return DeterminantLanes<1>(a, det.data(), begin, end);
+          case 2:
+            return DeterminantLanes<2>(a, det.data(), begin, end);
+          case 3:
+            return DeterminantLanes<3>(a, det.data(), begin, end);
+          case 4:
+            return DeterminantLanes<4>(a, det.data(), begin, end);
+        }
+        std::vector<T> m(n * n);
+        for (int64_t b = begin; b < end; ++b) {
+          for (int k = 0; k < n * n; ++k) m[k] = lanes(k / n, k % n)[b];
+          det[b] = Eliminate(m.data(), static_cast<T *>(nullptr), n);
+        }
+      });
+  return det;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  if (rows_ != cols_)
+    throw MatrixException(
+        "InverseMatrix: Matrix must be square to compute inverse.");
+  const int n = rows_;
+  S21BasicMatrixBatch result(count_, n, n);
+  std::vector<T> det(count_);
+  Lanes<T> a = {};
+  MutableLanes<T> out = {};
+  for (int k = 0; n <= 4 && k < n * n; ++k) {
+    a.e[k] = lanes(k / n, k % n);
+    out.e[k] = result.lanes(k / n, k % n);
+  }
+  S21ThreadPool::ForRange(
+      count_, static_cast<size_t>(count_) * n * n * n,
+      [&](int64_t begin, int64_t end) {
+        switch (n) {
+          case 1:
+            return InverseLanes<1>(a, out, det.data(), begin, end);
+          case 2:
+            return InverseLanes<2>(a, out, det.data(), begin, end);
+          case 3:
+            return InverseLanes<3>(a, out, det.data(), begin, end);
+          case 4:
+            return InverseLanes<4>(a, out, det.data(), begin, end);
+        }
+        std::vector<T> m(n * n), inverse(n * n);
+        for (int64_t b = begin; b < end; ++b) {
+          for (int k = 0; k < n * n; ++k) {
+            m[k] = lanes(k / n, k % n)[b];
+            inverse[k] = T(k / n == k % n ? 1 : 0);
+          }
+          det[b] = Eliminate(m.data(), inverse.data(), n);
+          for (int k = 0; k < n * n; ++k)
+            result.lanes(k / n, k % n)[b] = inverse[k];
+        }
+      });
+  if (std::find(det.begin(), det.end(), T(0)) != det.end())
+    throw MatrixException(
+        "InverseMatrix: Matrix determinant is 0, the matrix is not "
+        "invertible.");
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator+(
+    const S21BasicMatrixBatch &other) const {
+  return SumMatrix(other);
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator*(
+    const S21BasicMatrixBatch &other) const {
+  return MulMatrix(other);
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
+template class S21BasicMatrixBatch<long double>;
+template class S21BasicMatrixBatch<std::complex<double>>;
@@ -0,0 +1,66 @@
+#ifndef S21_MATRIX_BATCH
+#define S21_MATRIX_BATCH
+
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_oop.h"
+
+// get_count() independent matrices of one shape, stored interleaved: the
+// values of element (i, j) across the batch are contiguous, padded to a
+// whole number of S21_MATRIX_ALIGNMENT blocks (get_lane_stride()). Every
+// operation walks the batch index innermost, so the same straight-line
+// code runs across adjacent matrices and the compiler vectorizes it, and
+// the batch is split over S21ThreadPool::Current(). Determinant and
+// inverse use closed forms up to 4x4 and per-matrix elimination beyond.
+// Instantiated for the same element types as S21BasicMatrix.
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  using value_type = T;
+  using Real = typename S21MatrixTraits<T>::Real;
+
+ private:
+  int count_, rows_, cols_, lane_stride_;
+  std::vector<T, S21AlignedAllocator<T>> data_;
+
+  static int LaneStrideFor(int count);
+  void CheckIndex(int index) const;
+
+ public:
+  S21BasicMatrixBatch();
+  S21BasicMatrixBatch(int count, int rows, int cols);
+
+  int get_count() const;
+  int get_rows() const;
+  int get_cols() const;
+  int get_lane_stride() const;
+  // The get_count() values of element (row, col), one per matrix.
+  T *lanes(int row, int col);
+  const T *lanes(int row, int col) const;
+
+  T &operator()(int index, int row, int col);
+  T operator()(int index, int row, int col) const;
+  void Set(int index, const S21BasicMatrix<T> &matrix);
+  S21BasicMatrix<T> Get(int index) const;
+
+  // Pairwise: matrix k of the result comes from matrix k of each operand.
+  S21BasicMatrixBatch SumMatrix(const S21BasicMatrixBatch &other) const;
+  S21BasicMatrixBatch MulMatrix(const S21BasicMatrixBatch &other) const;
+  S21BasicMatrixBatch Transpose() const;
+  std::vector<T> Determinant() const;
+  // Throws when any matrix of the batch is singular.
+  S21BasicMatrixBatch InverseMatrix() const;
+
+  S21BasicMatrixBatch operator+(const S21BasicMatrixBatch &other) const;
+  S21BasicMatrixBatch operator*(const S21BasicMatrixBatch &other) const;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+extern template class S21BasicMatrixBatch<long double>;
+extern template class S21BasicMatrixBatch<std::complex<double>>;
+
+#endif  // S21_MATRIX_BATCH
@@ -0,0 +1,328 @@
+#include "s21_matrix_counters.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+constexpr int kOps = static_cast<int>(S21Op::kCount);
+constexpr int kCells = kOps * S21Counters::kShapeBuckets;
+
+const char *const kOpNames[kOps] = {
+    "Other",       "isCorrect",       "EqMatrix",  "SumMatrix",
+    "SubMatrix",   "MulNumber",       "Axpy",      "MulMatrix",
+    "Determinant", "CalcComplements", "Transpose", "InverseMatrix",
+    "Solve",       "LeastSquares"};
+
+// Only the owning thread writes a cell, so a relaxed load and store is
+// enough to add; other threads merely read it.
+using Counter = std::atomic<uint64_t>;
+
+void Add(Counter &counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+struct Cell {
+  Counter calls{0}, nanoseconds{0}, flops{0}, allocated{0}, copied{0};
+  Counter instructions{0}, cache_misses{0};
+  std::array<Counter, S21OpStats::kLatencyBuckets> latency{};
+
+  void MergeInto(S21OpStats &stats) const {
+    stats.calls += calls.load(std::memory_order_relaxed);
+    stats.nanoseconds += nanoseconds.load(std::memory_order_relaxed);
+    stats.flops += flops.load(std::memory_order_relaxed);
+    stats.bytes_allocated += allocated.load(std::memory_order_relaxed);
+    stats.bytes_copied += copied.load(std::memory_order_relaxed);
+    stats.instructions += instructions.load(std::memory_order_relaxed);
+    stats.cache_misses += cache_misses.load(std::memory_order_relaxed);
+    for (int b = 0; b < S21OpStats::kLatencyBuckets; ++b)
+      stats.latency[b] += latency[b].load(std::memory_order_relaxed);
+  }
+  void MergeInto(Cell &cell) const {
+    S21OpStats sums{};
+    MergeInto(sums);
+    Add(cell.calls, sums.calls);
+    Add(cell.nanoseconds, sums.nanoseconds);
+    Add(cell.flops, sums.flops);
+    Add(cell.allocated, sums.bytes_allocated);
+    Add(cell.copied, sums.bytes_copied);
+    Add(cell.instructions, sums.instructions);
+    Add(cell.cache_misses, sums.cache_misses);
+    for (int b = 0; b < S21OpStats::kLatencyBuckets; ++b)
+      Add(cell.latency[b], sums.latency[b]);
+  }
+  void Clear() {
+    for (Counter *c : {&calls, &nanoseconds, &flops, &allocated, &copied,
+                       &instructions, &cache_misses})
+      c->store(0, std::memory_order_relaxed);
+    for (Counter &c : latency) c.store(0, std::memory_order_relaxed);
+  }
+};
+
+std::atomic<bool> hardware_enabled{false};
+
+// The counters of one thread, and its perf_event group: instructions as
+// the leader, cache misses as the member, read together.
+struct ThreadCounters {
+  std::array<Cell, kCells> cells;
+  int leader = -1, member = -1;
+  bool opened = false;
+
+  ~ThreadCounters() {
+    if (member >= 0) close(member);
+    if (leader >= 0) close(leader);
+  }
+  Cell &At(S21Op op, int shape) {
+    return cells[static_cast<int>(op) * S21Counters::kShapeBuckets + shape];
+  }
+  bool OpenHardware();
+  bool ReadHardware(uint64_t values[2]) const;
+};
+
+#ifdef __linux__
+int OpenEvent(uint64_t config, int group) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group,
+                                  PERF_FLAG_FD_CLOEXEC));
+}
+
+bool ThreadCounters::OpenHardware() {
+  if (opened) return leader >= 0;
+  opened = true;
+  leader = OpenEvent(PERF_COUNT_HW_INSTRUCTIONS, -1);
+  if (leader >= 0) member = OpenEvent(PERF_COUNT_HW_CACHE_MISSES, leader);
+  if (member < 0 && leader >= 0) {
+    close(leader);
+    leader = -1;
+  }
+  return leader >= 0;
+}
+
+bool ThreadCounters::ReadHardware(uint64_t values[2]) const {
+  struct {
+    uint64_t count;
+    uint64_t values[2];
+  } group;
+  if (read(leader, &group, sizeof(group)) != sizeof(group)) return false;
+  values[0] = group.values[0];
+  values[1] = group.values[1];
+  return true;
+}
+#else
+bool ThreadCounters::OpenHardware() { return false; }
+
+bool ThreadCounters::ReadHardware(uint64_t *) const { return false; }
+#endif
+
+// Counters of the live threads, and the sums of the exited ones. Never
+// destroyed, so that threads exiting during static destruction can still
+// hand their counters over.
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadCounters *> live;
+  ThreadCounters retired;
+};
+
+Registry &GetRegistry() {
+  static Registry *registry = new Registry;
+  return *registry;
+}
+
+// Registers the thread's counters on first use and folds them into
+// Registry::retired when the thread exits.
+class LocalCounters {
+ public:
+  ~LocalCounters() {
+    if (!counters_) return;
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (int i = 0; i < kCells; ++i)
+      counters_->cells[i].MergeInto(registry.retired.cells[i]);
+    auto &live = registry.live;
+    live.erase(std::find(live.begin(), live.end(), counters_.get()));
+  }
+  ThreadCounters &Get() {
+    if (!counters_) {
+      counters_ = std::make_unique<ThreadCounters>();
+      Registry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.live.push_back(counters_.get());
+    }
+    return *counters_;
+  }
+
+ private:
+  std::unique_ptr<ThreadCounters> counters_;
+};
+
+thread_local LocalCounters tls_counters;
+// Innermost open probe of this thread.
+thread_local S21OpProbe *tls_probe = nullptr;
+
+int LatencyBucket(uint64_t nanoseconds) {
+  if (nanoseconds < 2) return 0;
+  return std::min(63 - __builtin_clzll(nanoseconds),
+                  S21OpStats::kLatencyBuckets - 1);
+}
+
+void AppendField(std::string &out, const char *name, uint64_t value) {
+  out += ", \"";
+  out += name;
+  out += "\": ";
+  out += std::to_string(value);
+}
+
+}  // namespace
+
+const char *S21Counters::OpName(S21Op op) {
+  return kOpNames[static_cast<int>(op)];
+}
+
+int S21Counters::ShapeBucket(int rows, int cols) {
+  const unsigned size = static_cast<unsigned>(std::max({rows, cols, 1}));
+  return std::min(31 - __builtin_clz(size), kShapeBuckets - 1);
+}
+
+std::string S21Counters::ShapeName(int shape) {
+  if (shape == 0) return "0-1";
+  std::string result = std::to_string(1 << shape);
+  if (shape == kShapeBuckets - 1) return result + "+";
+  return result + "-" + std::to_string((2 << shape) - 1);
+}
+
+std::vector<S21OpStats> S21Counters::Snapshot() {
+  std::vector<S21OpStats> result;
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (int i = 0; i < kCells; ++i) {
+    S21OpStats stats{};
+    stats.op = static_cast<S21Op>(i / kShapeBuckets);
+    stats.shape = i % kShapeBuckets;
+    registry.retired.cells[i].MergeInto(stats);
+    for (const ThreadCounters *counters : registry.live)
+      counters->cells[i].MergeInto(stats);
+    if (stats.calls || stats.bytes_allocated || stats.bytes_copied)
+      result.push_back(stats);
+  }
+  return result;
+}
+
+std::string S21Counters::SnapshotJson() {
+  std::string out = "{\"hardware_counters\": ";
+  out += HardwareCountersEnabled() ? "true" : "false";
+  out += ", \"operations\": [";
+  bool first = true;
+  for (const S21OpStats &stats : Snapshot()) {
+    out += first ? "\n  {\"op\": \"" : ",\n  {\"op\": \"";
+    first = false;
+    out += OpName(stats.op);
+    out += "\", \"shape\": \"";
+    out += stats.op == S21Op::kOther ? "any" : ShapeName(stats.shape);
+    out += "\"";
+    AppendField(out, "calls", stats.calls);
+    AppendField(out, "nanoseconds", stats.nanoseconds);
+    AppendField(out, "flops", stats.flops);
+    AppendField(out, "bytes_allocated", stats.bytes_allocated);
+    AppendField(out, "bytes_copied", stats.bytes_copied);
+    AppendField(out, "instructions", stats.instructions);
+    AppendField(out, "cache_misses", stats.cache_misses);
+    out += ", \"latency\": {";
+    const char *separator = "";
+    for (int b = 0; b < S21OpStats::kLatencyBuckets; ++b) {
+      if (!stats.latency[b]) continue;
+      out += separator;
+      out += "\"" + std::to_string(b ? uint64_t(1) << b : 0) + "\": ";
+      out += std::to_string(stats.latency[b]);
+      separator = ", ";
+    }
+    out += "}}";
+  }
+  out += first ? "]}" : "\n]}";
+  return out;
+}
+
+void S21Counters::Reset() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (Cell &cell : registry.retired.cells) cell.Clear();
+  for (ThreadCounters *counters : registry.live)
+    for (Cell &cell : counters->cells) cell.Clear();
+}
+
+bool S21Counters::EnableHardwareCounters(bool enable) {
+  if (enable && !tls_counters.Get().OpenHardware()) return false;
+  hardware_enabled.store(enable, std::memory_order_relaxed);
+  return true;
+}
+
+bool S21Counters::HardwareCountersEnabled() {
+  return hardware_enabled.load(std::memory_order_relaxed);
+}
+
+S21OpProbe::S21OpProbe(S21Op op, int rows, int cols)
+    : op_(op),
+      shape_(S21Counters::ShapeBucket(rows, cols)),
+      flops_(0),
+      allocated_(0),
+      copied_(0),
+      hardware_(false),
+      outer_(tls_probe) {
+  tls_probe = this;
+  if (hardware_enabled.load(std::memory_order_relaxed)) {
+    ThreadCounters &counters = tls_counters.Get();
+    hardware_ = counters.OpenHardware() &&
+                counters.ReadHardware(hardware_start_);
+  }
+  start_ = std::chrono::steady_clock::now();
+}
+
+S21OpProbe::~S21OpProbe() {
+  const uint64_t nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_)
+          .count();
+  tls_probe = outer_;
+  ThreadCounters &counters = tls_counters.Get();
+  Cell &cell = counters.At(op_, shape_);
+  Add(cell.calls, 1);
+  Add(cell.nanoseconds, nanoseconds);
+  Add(cell.latency[LatencyBucket(nanoseconds)], 1);
+  if (flops_) Add(cell.flops, flops_);
+  if (allocated_) Add(cell.allocated, allocated_);
+  if (copied_) Add(cell.copied, copied_);
+  uint64_t hardware_end[2];
+  if (hardware_ && counters.ReadHardware(hardware_end)) {
+    Add(cell.instructions, hardware_end[0] - hardware_start_[0]);
+    Add(cell.cache_misses, hardware_end[1] - hardware_start_[1]);
+  }
+}
+
+void S21OpProbe::CountAllocated(size_t bytes) {
+  if (tls_probe)
+    tls_probe->allocated_ += bytes;
+  else
+    Add(tls_counters.Get().At(S21Op::kOther, 0).allocated, bytes);
+}
+
+void S21OpProbe::CountCopied(size_t bytes) {
+  if (tls_probe)
+    tls_probe->copied_ += bytes;
+  else
+    Add(tls_counters.Get().At(S21Op::kOther, 0).copied, bytes);
+}
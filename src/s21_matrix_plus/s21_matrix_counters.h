@@ -0,0 +1,128 @@
+#ifndef S21_MATRIX_COUNTERS
+#define S21_MATRIX_COUNTERS
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Operations counters are kept for. Allocations and copies made outside
+// any of them are counted under kOther, which has no calls and no shape.
+enum class S21Op {
+  kOther,
+  kIsCorrect,
+  kEqMatrix,
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kAxpy,
+  kMulMatrix,
+  kDeterminant,
+  kCalcComplements,
+  kTranspose,
+  kInverseMatrix,
+  kSolve,
+  kLeastSquares,
+  kCount
+};
+
+// Totals of one operation on one shape bucket.
+struct S21OpStats {
+  static constexpr int kLatencyBuckets = 32;
+
+  S21Op op;
+  int shape;
+  uint64_t calls, nanoseconds, flops, bytes_allocated, bytes_copied;
+  // Hardware counters, zero unless they were enabled.
+  uint64_t instructions, cache_misses;
+  // latency[b] counts the calls that took [2^b, 2^(b + 1)) ns; the first
+  // bucket also holds 0 ns and the last everything longer.
+  std::array<uint64_t, kLatencyBuckets> latency;
+};
+
+// Per-operation performance counters. The library records them only when
+// built with S21_MATRIX_INSTRUMENT defined (make INSTRUMENT=1); otherwise
+// the probes below compile to nothing and every snapshot is empty.
+//
+// Every thread records into its own counters, without locks or atomic
+// read-modify-writes; Snapshot() sums them over the live threads and the
+// ones that have exited. Times are inclusive: an operation calling another
+// one counts the callee's time too, while allocations and copies go to
+// the innermost operation only. FLOPs are the nominal counts of the
+// classical algorithms, one per element addition or multiplication,
+// whichever algorithm actually ran.
+//
+// A probe reads the clock twice, about 90 ns in all, so an instrumented
+// build runs a 4 x 4 SumMatrix (isCorrect is probed too) ten times slower;
+// above a few hundred elements per call the cost is lost in the noise.
+class S21Counters {
+ public:
+  // Shape buckets are powers of two of the larger dimension: bucket b
+  // holds [2^b, 2^(b + 1)), the first one also 0 and the last anything
+  // larger.
+  static constexpr int kShapeBuckets = 16;
+
+  static const char *OpName(S21Op op);
+  static int ShapeBucket(int rows, int cols);
+  // The bucket's range of the larger dimension, e.g. "64-127".
+  static std::string ShapeName(int shape);
+
+  // The non-empty counters, ordered by operation and shape.
+  static std::vector<S21OpStats> Snapshot();
+  // Snapshot() as a JSON object {"hardware_counters": bool, "operations":
+  // [...]}, one member per S21OpStats field and the latency histogram as
+  // {"<lower bound in ns>": calls} without the empty buckets.
+  static std::string SnapshotJson();
+  // Counts recorded while Reset runs on another thread may survive it.
+  static void Reset();
+
+  // Reads instructions and cache misses through perf_event_open around
+  // every operation that starts afterwards, on every thread. Returns false
+  // and leaves them off when the kernel refuses (not Linux, no PMU access
+  // or perf_event_paranoid too high). Costs two system calls per
+  // operation, so it is off by default.
+  static bool EnableHardwareCounters(bool enable);
+  static bool HardwareCountersEnabled();
+};
+
+// Records one call of `op` on the calling thread, from construction to
+// destruction. Library code uses the S21_MATRIX_* macros below instead so
+// that it compiles to nothing without S21_MATRIX_INSTRUMENT.
+class S21OpProbe {
+ public:
+  S21OpProbe(S21Op op, int rows, int cols);
+  S21OpProbe(const S21OpProbe &) = delete;
+  S21OpProbe &operator=(const S21OpProbe &) = delete;
+  ~S21OpProbe();
+
+  void AddFlops(uint64_t flops) { flops_ += flops; }
+  // Charged to the innermost probe of the thread, or to S21Op::kOther.
+  static void CountAllocated(size_t bytes);
+  static void CountCopied(size_t bytes);
+
+ private:
+  S21Op op_;
+  int shape_;
+  uint64_t flops_, allocated_, copied_;
+  bool hardware_;
+  uint64_t hardware_start_[2];
+  std::chrono::steady_clock::time_point start_;
+  S21OpProbe *outer_;
+};
+
+#ifdef S21_MATRIX_INSTRUMENT
+#define S21_MATRIX_PROBE(op, rows, cols) \
+  S21OpProbe s21_probe(S21Op::op, rows, cols)
+#define S21_MATRIX_FLOPS(flops) s21_probe.AddFlops(flops)
+#define S21_MATRIX_ALLOCATED(bytes) S21OpProbe::CountAllocated(bytes)
+#define S21_MATRIX_COPIED(bytes) S21OpProbe::CountCopied(bytes)
+#else
+#define S21_MATRIX_PROBE(op, rows, cols) ((void)0)
+#define S21_MATRIX_FLOPS(flops) ((void)0)
+#define S21_MATRIX_ALLOCATED(bytes) ((void)0)
+#define S21_MATRIX_COPIED(bytes) ((void)0)
+#endif
+
+#endif  // S21_MATRIX_COUNTERS
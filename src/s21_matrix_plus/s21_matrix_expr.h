@@ -0,0 +1,161 @@
+#ifndef S21_MATRIX_EXPR
+#define S21_MATRIX_EXPR
+
+#include <type_traits>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_traits.h"
+
+// Lazy elementwise expressions over matrices. `a + b * 2.0 - c` builds a
+// small tree of expression objects instead of three temporaries; the tree
+// is evaluated in a single pass, with a single allocation, when it is
+// assigned to a matrix. Expressions refer to their matrix operands, so
+// they must not outlive the statement that created them.
+
+template <typename T>
+class S21BasicMatrix;
+
+// CRTP base of everything that can appear in an elementwise expression.
+// Derived classes provide value_type, get_rows(), get_cols(),
+// Coeff(i, j) and ReadsShifted(begin, end): whether element (i, j) of the
+// expression may depend on an element of the storage [begin, end) other
+// than (i, j), which makes evaluating it in place into that storage unsafe.
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E &self() const { return static_cast<const E &>(*this); }
+  int get_rows() const { return self().get_rows(); }
+  int get_cols() const { return self().get_cols(); }
+  auto Coeff(int i, int j) const { return self().Coeff(i, j); }
+  bool ReadsShifted(const void *begin, const void *end) const {
+    return self().ReadsShifted(begin, end);
+  }
+};
+
+// Matrices are held by reference, intermediate expression nodes by value.
+template <typename E>
+struct S21ExprStorage {
+  using type = const E;
+};
+template <typename T>
+struct S21ExprStorage<S21BasicMatrix<T>> {
+  using type = const S21BasicMatrix<T> &;
+};
+
+struct S21AddOp {
+  template <typename T>
+  static T Apply(const T &a, const T &b) {
+    return a + b;
+  }
+  static constexpr const char *kMismatch =
+      "SumMatrix: Matrices dimensions do not match for addition.";
+};
+
+struct S21SubOp {
+  template <typename T>
+  static T Apply(const T &a, const T &b) {
+    return a - b;
+  }
+  static constexpr const char *kMismatch =
+      "SubMatrix: Matrices dimensions do not match for subtraction.";
+};
+
+template <typename L, typename R, typename Op>
+class S21BinaryExpr : public S21MatrixExpr<S21BinaryExpr<L, R, Op>> {
+  static_assert(std::is_same<typename L::value_type,
+                             typename R::value_type>::value,
+                "Operands of an expression must have the same element type.");
+
+ private:
+  typename S21ExprStorage<L>::type lhs_;
+  typename S21ExprStorage<R>::type rhs_;
+
+ public:
+  using value_type = typename L::value_type;
+
+  S21BinaryExpr(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.get_rows() != rhs.get_rows() || lhs.get_cols() != rhs.get_cols())
+      throw MatrixException(Op::kMismatch);
+  }
+  int get_rows() const { return lhs_.get_rows(); }
+  int get_cols() const { return lhs_.get_cols(); }
+  value_type Coeff(int i, int j) const {
+    return Op::Apply(lhs_.Coeff(i, j), rhs_.Coeff(i, j));
+  }
+  bool ReadsShifted(const void *begin, const void *end) const {
+    return lhs_.ReadsShifted(begin, end) || rhs_.ReadsShifted(begin, end);
+  }
+};
+
+template <typename E>
+class S21ScaledExpr : public S21MatrixExpr<S21ScaledExpr<E>> {
+ public:
+  using value_type = typename E::value_type;
+
+ private:
+  typename S21ExprStorage<E>::type operand_;
+  value_type num_;
+
+ public:
+  S21ScaledExpr(const E &operand, value_type num)
+      : operand_(operand), num_(num) {}
+  int get_rows() const { return operand_.get_rows(); }
+  int get_cols() const { return operand_.get_cols(); }
+  value_type Coeff(int i, int j) const { return operand_.Coeff(i, j) * num_; }
+  bool ReadsShifted(const void *begin, const void *end) const {
+    return operand_.ReadsShifted(begin, end);
+  }
+};
+
+// Zero-copy transpose of a matrix: element (i, j) reads (j, i) of the
+// viewed matrix, which must outlive the view. It can be read directly or
+// used as an expression operand; assigning it to the matrix it views
+// evaluates through a temporary.
+template <typename T>
+class S21TransposeView : public S21MatrixExpr<S21TransposeView<T>> {
+ private:
+  const S21BasicMatrix<T> &matrix_;
+
+ public:
+  using value_type = T;
+
+  explicit S21TransposeView(const S21BasicMatrix<T> &matrix)
+      : matrix_(matrix) {}
+  int get_rows() const { return matrix_.get_cols(); }
+  int get_cols() const { return matrix_.get_rows(); }
+  T Coeff(int i, int j) const { return matrix_.Coeff(j, i); }
+  T operator()(int row, int col) const { return matrix_(col, row); }
+  bool ReadsShifted(const void *begin, const void *) const {
+    return begin == matrix_.data();
+  }
+};
+
+template <typename L, typename R>
+S21BinaryExpr<L, R, S21AddOp> operator+(const S21MatrixExpr<L> &lhs,
+                                        const S21MatrixExpr<R> &rhs) {
+  return S21BinaryExpr<L, R, S21AddOp>(lhs.self(), rhs.self());
+}
+
+template <typename L, typename R>
+S21BinaryExpr<L, R, S21SubOp> operator-(const S21MatrixExpr<L> &lhs,
+                                        const S21MatrixExpr<R> &rhs) {
+  return S21BinaryExpr<L, R, S21SubOp>(lhs.self(), rhs.self());
+}
+
+// The factor is converted to the element type of the expression, so a
+// float matrix times 2.0 stays in float arithmetic.
+template <typename E, typename S,
+          typename = std::enable_if_t<S21IsScalar<S>::value>>
+S21ScaledExpr<E> operator*(const S21MatrixExpr<E> &operand, const S &num) {
+  return S21ScaledExpr<E>(operand.self(),
+                          static_cast<typename E::value_type>(num));
+}
+
+template <typename E, typename S,
+          typename = std::enable_if_t<S21IsScalar<S>::value>>
+S21ScaledExpr<E> operator*(const S &num, const S21MatrixExpr<E> &operand) {
+  return S21ScaledExpr<E>(operand.self(),
+                          static_cast<typename E::value_type>(num));
+}
+
+#endif  // S21_MATRIX_EXPR
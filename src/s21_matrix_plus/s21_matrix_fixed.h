@@ -0,0 +1,268 @@
+#ifndef S21_MATRIX_FIXED
+#define S21_MATRIX_FIXED
+
+#include <type_traits>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Matrix whose shape is part of its type: the elements live inline (on the
+// stack for locals), every operation is constexpr, and operands of the
+// wrong shape do not compile. Meant for the 2x2 - 4x4 transforms that
+// would otherwise pay for a heap allocation and runtime checks per
+// operation. Determinant and inverse use closed forms up to 4x4 and
+// Gaussian elimination beyond.
+template <int R, int C, typename T = double>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Matrix dimensions must be positive.");
+  static_assert(std::is_floating_point<T>::value,
+                "Fixed-size matrices hold real elements.");
+
+ public:
+  using value_type = T;
+  using Real = typename S21MatrixTraits<T>::Real;
+
+ private:
+  T data_[R * C] = {};
+
+  static constexpr Real Abs(const T &value) {
+    return value < T(0) ? -value : value;
+  }
+
+ public:
+  constexpr S21FixedMatrix() = default;
+  // Row-major elements; missing trailing ones are zero. Explicit, so a
+  // scalar never converts into a matrix: `m + 2.0` and `m == 1.0` do not
+  // compile.
+  template <typename... Values,
+            typename = std::enable_if_t<
+                (sizeof...(Values) > 0 && sizeof...(Values) <= R * C &&
+                 std::conjunction<std::is_arithmetic<Values>...>::value)>>
+  explicit constexpr S21FixedMatrix(Values... values)
+      : data_{static_cast<T>(values)...} {}
+
+  // Throws when `matrix` does not have R rows and C columns.
+  explicit S21FixedMatrix(const S21BasicMatrix<T> &matrix) {
+    if (matrix.get_rows() != R || matrix.get_cols() != C)
+      throw MatrixException(
+          "S21FixedMatrix: Dynamic matrix dimensions do not match.");
+    for (int i = 0; i < R; ++i)
+      for (int j = 0; j < C; ++j) data_[i * C + j] = matrix.row(i)[j];
+  }
+  S21BasicMatrix<T> ToMatrix() const {
+    S21BasicMatrix<T> result(R, C);
+    for (int i = 0; i < R; ++i)
+      for (int j = 0; j < C; ++j) result.row(i)[j] = data_[i * C + j];
+    return result;
+  }
+  explicit operator S21BasicMatrix<T>() const { return ToMatrix(); }
+
+  static constexpr S21FixedMatrix Identity() {
+    static_assert(R == C, "Identity matrix must be square.");
+    S21FixedMatrix result;
+    for (int i = 0; i < R; ++i) result(i, i) = T(1);
+    return result;
+  }
+
+  static constexpr int get_rows() { return R; }
+  static constexpr int get_cols() { return C; }
+  constexpr T &operator()(int row, int col) { return data_[row * C + col]; }
+  constexpr const T &operator()(int row, int col) const {
+    return data_[row * C + col];
+  }
+  constexpr T *data() { return data_; }
+  constexpr const T *data() const { return data_; }
+
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const {
+    for (int k = 0; k < R * C; ++k)
+      if (Abs(data_[k] - other.data_[k]) > S21MatrixTraits<T>::kEpsilon)
+        return false;
+    return true;
+  }
+  constexpr bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    for (int k = 0; k < R * C; ++k) data_[k] += other.data_[k];
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    for (int k = 0; k < R * C; ++k) data_[k] -= other.data_[k];
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(T num) {
+    for (int k = 0; k < R * C; ++k) data_[k] *= num;
+    return *this;
+  }
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix &other) const {
+    return S21FixedMatrix(*this) += other;
+  }
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix &other) const {
+    return S21FixedMatrix(*this) -= other;
+  }
+  constexpr S21FixedMatrix operator*(T num) const {
+    return S21FixedMatrix(*this) *= num;
+  }
+  friend constexpr S21FixedMatrix operator*(T num, const S21FixedMatrix &m) {
+    return m * num;
+  }
+
+  template <int N>
+  constexpr S21FixedMatrix<R, N, T> operator*(
+      const S21FixedMatrix<C, N, T> &other) const {
+    S21FixedMatrix<R, N, T> result;
+    for (int i = 0; i < R; ++i)
+      for (int k = 0; k < C; ++k)
+        for (int j = 0; j < N; ++j)
+          result(i, j) += (*this)(i, k) * other(k, j);
+    return result;
+  }
+  // Square operands only: any other shape changes the type of *this.
+  constexpr S21FixedMatrix &operator*=(const S21FixedMatrix &other) {
+    static_assert(R == C, "Operator*=: Matrix must be square.");
+    return *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R, T> Transpose() const {
+    S21FixedMatrix<C, R, T> result;
+    for (int i = 0; i < R; ++i)
+      for (int j = 0; j < C; ++j) result(j, i) = (*this)(i, j);
+    return result;
+  }
+
+  constexpr S21FixedMatrix<R - 1, C - 1, T> Minor(int r, int c) const {
+    static_assert(R > 1 && C > 1, "Minor: Matrix must be at least 2x2.");
+    S21FixedMatrix<R - 1, C - 1, T> result;
+    for (int i = 0, x = 0; i < R - 1; ++i, ++x) {
+      if (x == r) ++x;
+      for (int j = 0, y = 0; j < C - 1; ++j, ++y) {
+        if (y == c) ++y;
+        result(i, j) = (*this)(x, y);
+      }
+    }
+    return result;
+  }
+
+  constexpr T Determinant() const {
+    static_assert(R == C, "Determinant: Matrix must be square.");
+    const S21FixedMatrix &m = *this;
+    if constexpr (R == 1) {
+      return m(0, 0);
+    } else if constexpr (R == 2) {
+      return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    } else if constexpr (R == 3) {
+      return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) -
+             m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+             m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+    } else if constexpr (R == 4) {
+      // Laplace expansion along the top two rows: products of their 2x2
+      // minors with the complementary minors of the bottom two rows.
+      T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+      T s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+      T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+      T s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+      T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+      T s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+      T c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+      T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+      T c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+      T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+      T c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+      T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+      return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    } else {
+      // Gaussian elimination with partial pivoting.
+      S21FixedMatrix a(m);
+      T result = T(1);
+      for (int k = 0; k < R; ++k) {
+        int pivot = k;
+        for (int i = k + 1; i < R; ++i)
+          if (Abs(a(i, k)) > Abs(a(pivot, k))) pivot = i;
+        if (a(pivot, k) == T(0)) return T(0);
+        if (pivot != k) {
+          for (int j = 0; j < R; ++j) {
+            T tmp = a(k, j);
+            a(k, j) = a(pivot, j);
+            a(pivot, j) = tmp;
+          }
+          result = -result;
+        }
+        result *= a(k, k);
+        for (int i = k + 1; i < R; ++i) {
+          T l = a(i, k) / a(k, k);
+          for (int j = k + 1; j < R; ++j) a(i, j) -= l * a(k, j);
+        }
+      }
+      return result;
+    }
+  }
+
+  constexpr S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "CalcComplements: Matrix must be square.");
+    S21FixedMatrix result;
+    if constexpr (R == 1) {
+      result(0, 0) = T(1);
+    } else {
+      for (int i = 0; i < R; ++i)
+        for (int j = 0; j < C; ++j)
+          result(i, j) = ((i + j) % 2 ? T(-1) : T(1)) *
+                         Minor(i, j).Determinant();
+    }
+    return result;
+  }
+
+  // Adjugate over determinant up to 4x4, Gauss-Jordan elimination beyond.
+  // Throws when the matrix is singular.
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "InverseMatrix: Matrix must be square.");
+    if constexpr (R <= 4) {
+      T det = Determinant();
+      if (det == T(0))
+        throw MatrixException(
+            "InverseMatrix: Matrix determinant is 0, the matrix is not "
+            "invertible.");
+      return CalcComplements().Transpose() * (T(1) / det);
+    } else {
+      S21FixedMatrix a(*this), result = Identity();
+      for (int k = 0; k < R; ++k) {
+        int pivot = k;
+        for (int i = k + 1; i < R; ++i)
+          if (Abs(a(i, k)) > Abs(a(pivot, k))) pivot = i;
+        if (a(pivot, k) == T(0))
+          throw MatrixException(
+              "InverseMatrix: Matrix determinant is 0, the matrix is not "
+              "invertible.");
+        for (int j = 0; j < R; ++j) {
+          T tmp = a(k, j);
+          a(k, j) = a(pivot, j);
+          a(pivot, j) = tmp;
+          tmp = result(k, j);
+          result(k, j) = result(pivot, j);
+          result(pivot, j) = tmp;
+        }
+        T scale = T(1) / a(k, k);
+        for (int j = 0; j < R; ++j) {
+          a(k, j) *= scale;
+          result(k, j) *= scale;
+        }
+        for (int i = 0; i < R; ++i) {
+          if (i == k) continue;
+          T l = a(i, k);
+          for (int j = 0; j < R; ++j) {
+            a(i, j) -= l * a(k, j);
+            result(i, j) -= l * result(k, j);
+          }
+        }
+      }
+      return result;
+    }
+  }
+};
+
+using S21Matrix2 = S21FixedMatrix<2, 2>;
+using S21Matrix3 = S21FixedMatrix<3, 3>;
+using S21Matrix4 = S21FixedMatrix<4, 4>;
+
+#endif  // S21_MATRIX_FIXED
@@ -0,0 +1,181 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+template <typename T>
+using Buffer = std::vector<T, S21AlignedAllocator<T>>;
+
+template <typename T>
+struct ScratchStack {
+  std::deque<Buffer<T>> buffers;
+  size_t depth = 0;
+};
+
+template <typename T>
+ScratchStack<T> &LocalScratchStack() {
+  thread_local ScratchStack<T> stack;
+  return stack;
+}
+
+// Per-thread packing buffer reused between calls, so steady-state
+// multiplication does not touch the allocator. A thread waiting inside
+// ParallelFor may run another GEMM, so buffers form a stack and a nested
+// call never reuses a buffer that is still in use further up.
+template <typename T>
+class Scratch {
+ public:
+  explicit Scratch(size_t size) : stack_(LocalScratchStack<T>()) {
+    if (stack_.buffers.size() <= stack_.depth)
+      stack_.buffers.emplace_back(S21AlignedAllocator<T>::Heap());
+    Buffer<T> &buffer = stack_.buffers[stack_.depth++];
+    if (buffer.size() < size) buffer.resize(size);
+    data_ = buffer.data();
+  }
+  Scratch(const Scratch &) = delete;
+  Scratch &operator=(const Scratch &) = delete;
+  ~Scratch() { --stack_.depth; }
+  T *data() const { return data_; }
+
+ private:
+  ScratchStack<T> &stack_;
+  T *data_;
+};
+
+// Copies an mc x kc block of A into MR-row slivers: for every k the MR
+// values of one sliver are contiguous. Rows past mc are zero-filled.
+template <typename T>
+void PackA(int mc, int kc, const T *a, size_t lda, T *packed) {
+  for (int i = 0; i < mc; i += kGemmMR) {
+    int mr = std::min(kGemmMR, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < mr; ++r) packed[r] = a[(i + r) * lda + p];
+      for (int r = mr; r < kGemmMR; ++r) packed[r] = T(0);
+      packed += kGemmMR;
+    }
+  }
+}
+
+// Copies a kc x nc panel of B into NR-column slivers: for every k the NR
+// values of one sliver are contiguous. Columns past nc are zero-filled.
+template <typename T>
+void PackB(int kc, int nc, const T *b, size_t ldb, T *packed) {
+  constexpr int kNR = kGemmNRFor<T>;
+  for (int j = 0; j < nc; j += kNR) {
+    int nr = std::min(kNR, nc - j);
+    for (int p = 0; p < kc; ++p) {
+      const T *src = b + p * ldb + j;
+      for (int r = 0; r < nr; ++r) packed[r] = src[r];
+      for (int r = nr; r < kNR; ++r) packed[r] = T(0);
+      packed += kNR;
+    }
+  }
+}
+
+// MR x NR register tile: acc = Apanel * Bpanel over kc, then
+// C (+)= alpha * acc. The fixed trip counts let the compiler keep acc in
+// vector registers.
+template <typename T>
+void MicroKernel(int kc, T alpha, const T *a, const T *b, T *c, size_t ldc,
+                 int mr, int nr, bool accumulate) {
+  constexpr int kNR = kGemmNRFor<T>;
+  T acc[kGemmMR][kNR] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int r = 0; r < kGemmMR; ++r) {
+      const T ar = a[r];
+      for (int q = 0; q < kNR; ++q) acc[r][q] += ar * b[q];
+    }
+    a += kGemmMR;
+    b += kNR;
+  }
+  for (int r = 0; r < mr; ++r) {
+    T *row = c + r * ldc;
+    if (accumulate) {
+      for (int q = 0; q < nr; ++q) row[q] += alpha * acc[r][q];
+    } else {
+      for (int q = 0; q < nr; ++q) row[q] = alpha * acc[r][q];
+    }
+  }
+}
+
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, T alpha, const T *packed_a,
+                 const T *packed_b, T *c, size_t ldc, bool accumulate) {
+  constexpr int kNR = kGemmNRFor<T>;
+  for (int i = 0; i < mc; i += kGemmMR) {
+    int mr = std::min(kGemmMR, mc - i);
+    for (int j = 0; j < nc; j += kNR) {
+      int nr = std::min(kNR, nc - j);
+      MicroKernel(kc, alpha, packed_a + i * kc, packed_b + j * kc,
+                  c + i * ldc + j, ldc, mr, nr, accumulate);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T *a, size_t lda, const T *b,
+          size_t ldb, T *c, size_t ldc, bool accumulate) {
+  constexpr int kNR = kGemmNRFor<T>;
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0) {
+    if (!accumulate)
+      for (int i = 0; i < m; ++i) std::fill(c + i * ldc, c + i * ldc + n, T(0));
+    return;
+  }
+  const size_t size_a = static_cast<size_t>(kGemmKC) *
+                        ((std::min(m, kGemmMC) + kGemmMR - 1) / kGemmMR *
+                         kGemmMR);
+  const size_t size_b = static_cast<size_t>(kGemmKC) *
+                        ((std::min(n, kGemmNC) + kNR - 1) / kNR * kNR);
+  Scratch<T> packed_b(size_b);
+  const int blocks = (m + kGemmMC - 1) / kGemmMC;
+
+  for (int jc = 0; jc < n; jc += kGemmNC) {
+    int nc = std::min(kGemmNC, n - jc);
+    for (int pc = 0; pc < k; pc += kGemmKC) {
+      int kc = std::min(kGemmKC, k - pc);
+      // Only the first k-block may overwrite C, the rest accumulate into it.
+      bool acc = accumulate || pc > 0;
+      PackB(kc, nc, b + pc * ldb + jc, ldb, packed_b.data());
+      // The MC-row blocks of C are independent: each task packs its own
+      // block of A and shares the packed panel of B.
+      S21ThreadPool::ForRange(
+          blocks, static_cast<size_t>(m) * nc * kc / kGemmKC,
+          [&](int64_t begin, int64_t end) {
+            Scratch<T> packed_a(size_a);
+            for (int64_t blk = begin; blk < end; ++blk) {
+              int ic = static_cast<int>(blk) * kGemmMC;
+              int mc = std::min(kGemmMC, m - ic);
+              PackA(mc, kc, a + ic * lda + pc, lda, packed_a.data());
+              MacroKernel(mc, nc, kc, alpha, packed_a.data(), packed_b.data(),
+                          c + ic * ldc + jc, ldc, acc);
+            }
+          });
+    }
+  }
+}
+
+template void Gemm<float>(int, int, int, float, const float *, size_t,
+                          const float *, size_t, float *, size_t, bool);
+template void Gemm<double>(int, int, int, double, const double *, size_t,
+                           const double *, size_t, double *, size_t, bool);
+template void Gemm<long double>(int, int, int, long double,
+                                const long double *, size_t,
+                                const long double *, size_t, long double *,
+                                size_t, bool);
+template void Gemm<std::complex<double>>(
+    int, int, int, std::complex<double>, const std::complex<double> *, size_t,
+    const std::complex<double> *, size_t, std::complex<double> *, size_t,
+    bool);
+
+}  // namespace s21
@@ -0,0 +1,33 @@
+#ifndef S21_MATRIX_GEMM
+#define S21_MATRIX_GEMM
+
+#include <complex>
+#include <cstddef>
+
+namespace s21 {
+
+// Cache blocking parameters of the GEMM engine. A packed KC x NR sliver of B
+// stays in L1, a packed MC x KC block of A in L2 and a KC x NC panel of B in
+// L3. MR x NR is the register tile computed by the micro-kernel.
+constexpr int kGemmMR = 4;
+constexpr int kGemmNR = 8;
+constexpr int kGemmKC = 256;
+constexpr int kGemmMC = 96;
+constexpr int kGemmNC = 2048;
+// The register tile is kGemmNR doubles wide; for other element types it
+// spans the same number of bytes, so float tiles are 16 columns wide.
+template <typename T>
+constexpr int kGemmNRFor = static_cast<int>(kGemmNR * sizeof(double) /
+                                            sizeof(T));
+
+// C = alpha * A * B, or C += alpha * A * B when `accumulate` is set. A is
+// m x k, B is k x n, C is m x n; all three are row-major with leading
+// dimensions lda/ldb/ldc. Instantiated for float, double, long double and
+// std::complex<double>.
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T *a, size_t lda, const T *b,
+          size_t ldb, T *c, size_t ldc, bool accumulate = false);
+
+}  // namespace s21
+
+#endif  // S21_MATRIX_GEMM
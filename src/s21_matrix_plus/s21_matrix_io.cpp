@@ -0,0 +1,224 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_exception.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr uint32_t kByteOrder = 0x01020304;
+
+template <typename T>
+constexpr uint32_t kDtype = 0;
+template <>
+constexpr uint32_t kDtype<float> = 1;
+template <>
+constexpr uint32_t kDtype<double> = 2;
+template <>
+constexpr uint32_t kDtype<long double> = 3;
+template <>
+constexpr uint32_t kDtype<std::complex<double>> = 4;
+
+// Same padding as S21BasicMatrix, so rows map onto its layout.
+template <typename T>
+int FileStride(int cols) {
+  constexpr int kPerLine = S21_MATRIX_ALIGNMENT / sizeof(T);
+  return (cols + kPerLine - 1) / kPerLine * kPerLine;
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrixWriter<T>::S21BasicMatrixWriter(const std::string &path,
+                                              int rows, int cols)
+    : rows_(rows), cols_(cols), stride_(FileStride<T>(cols)),
+      rows_written_(0) {
+  if (rows <= 0 || cols <= 0)
+    throw MatrixException("MatrixWriter: Matrix cols/rows out of range");
+  file_.open(path, std::ios::binary | std::ios::trunc);
+  if (!file_) throw MatrixException("MatrixWriter: Cannot open " + path);
+  S21MatrixFileHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dtype = kDtype<T>;
+  header.element_size = sizeof(T);
+  header.byte_order = kByteOrder;
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride_;
+  header.alignment = S21_MATRIX_ALIGNMENT;
+  header.data_offset = sizeof(header);
+  file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+template <typename T>
+int S21BasicMatrixWriter<T>::get_rows_written() const {
+  return rows_written_;
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::WriteRow(const T *row) {
+  if (rows_written_ == rows_)
+    throw MatrixException("WriteRow: All rows are already written.");
+  static const T padding[S21_MATRIX_ALIGNMENT / sizeof(T)] = {};
+  file_.write(reinterpret_cast<const char *>(row), sizeof(T) * cols_);
+  file_.write(reinterpret_cast<const char *>(padding),
+              sizeof(T) * (stride_ - cols_));
+  ++rows_written_;
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::WriteRows(S21BasicMatrixView<const T> rows) {
+  if (rows.get_cols() != cols_ || rows_written_ + rows.get_rows() > rows_)
+    throw MatrixException(
+        "WriteRows: Rows do not match the dimensions of the file.");
+  for (int i = 0; i < rows.get_rows(); ++i) WriteRow(rows.row(i));
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::Close() {
+  if (!file_.is_open()) return;
+  bool complete = rows_written_ == rows_;
+  file_.close();
+  if (!complete) throw MatrixException("Close: Not all rows were written.");
+  if (!file_) throw MatrixException("Close: Writing the file failed.");
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::Save(const S21BasicMatrix<T> &matrix,
+                                   const std::string &path) {
+  S21BasicMatrixWriter writer(path, matrix.get_rows(), matrix.get_cols());
+  writer.WriteRows(matrix);
+  writer.Close();
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(const std::string &path)
+    : mapping_(nullptr), mapping_size_(0), data_(nullptr), rows_(0),
+      cols_(0), stride_(0) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw MatrixException("MappedMatrix: Cannot open " + path);
+  struct stat st;
+  if (::fstat(fd, &st) == 0 &&
+      static_cast<size_t>(st.st_size) >= sizeof(S21MatrixFileHeader)) {
+    mapping_size_ = st.st_size;
+    mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping_ == MAP_FAILED) mapping_ = nullptr;
+  }
+  ::close(fd);
+  if (!mapping_) throw MatrixException("MappedMatrix: Cannot map " + path);
+
+  S21MatrixFileHeader header;
+  std::memcpy(&header, mapping_, sizeof(header));
+  const char *error = nullptr;
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+    error = "MappedMatrix: Not a matrix file.";
+  else if (header.byte_order != kByteOrder)
+    error = "MappedMatrix: File byte order does not match this machine.";
+  else if (header.version != S21BasicMatrixWriter<T>::kVersion)
+    error = "MappedMatrix: Unsupported file version.";
+  else if (header.dtype != kDtype<T> || header.element_size != sizeof(T))
+    error = "MappedMatrix: File element type does not match.";
+  else if (header.rows == 0 || header.cols == 0 ||
+           header.rows > INT32_MAX || header.stride < header.cols ||
+           header.stride > INT32_MAX ||
+           header.data_offset % alignof(T) != 0 ||
+           header.data_offset > mapping_size_ ||
+           (mapping_size_ - header.data_offset) / sizeof(T) / header.stride <
+               header.rows)
+    error = "MappedMatrix: File is truncated or corrupt.";
+  if (error) {
+    Unmap();
+    throw MatrixException(error);
+  }
+  rows_ = header.rows;
+  cols_ = header.cols;
+  stride_ = header.stride;
+  data_ = reinterpret_cast<const T *>(static_cast<const char *>(mapping_) +
+                                      header.data_offset);
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(
+    S21BasicMappedMatrix &&other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      data_(std::exchange(other.data_, nullptr)),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      stride_(std::exchange(other.stride_, 0)) {}
+
+template <typename T>
+S21BasicMappedMatrix<T> &S21BasicMappedMatrix<T>::operator=(
+    S21BasicMappedMatrix &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+    stride_ = std::exchange(other.stride_, 0);
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::~S21BasicMappedMatrix() {
+  Unmap();
+}
+
+template <typename T>
+void S21BasicMappedMatrix<T>::Unmap() {
+  if (mapping_) ::munmap(mapping_, mapping_size_);
+  mapping_ = nullptr;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::get_rows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::get_cols() const {
+  return cols_;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::get_stride() const {
+  return stride_;
+}
+
+template <typename T>
+const T *S21BasicMappedMatrix<T>::data() const {
+  return data_;
+}
+
+template <typename T>
+T S21BasicMappedMatrix<T>::operator()(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("Operator(): Index out of bounds.");
+  return data_[static_cast<size_t>(row) * stride_ + col];
+}
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMappedMatrix<T>::View() const {
+  return S21BasicMatrixView<const T>(data_, rows_, cols_, stride_);
+}
+
+template class S21BasicMatrixWriter<float>;
+template class S21BasicMatrixWriter<double>;
+template class S21BasicMatrixWriter<long double>;
+template class S21BasicMatrixWriter<std::complex<double>>;
+template class S21BasicMappedMatrix<float>;
+template class S21BasicMappedMatrix<double>;
+template class S21BasicMappedMatrix<long double>;
+template class S21BasicMappedMatrix<std::complex<double>>;
@@ -0,0 +1,107 @@
+#ifndef S21_MATRIX_IO
+#define S21_MATRIX_IO
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_view.h"
+
+// Binary matrix files. A 64-byte header is followed by the elements, row
+// major, in the layout of S21BasicMatrix: every row is padded with zeros
+// to a multiple of the alignment recorded in the header. The data starts
+// at data_offset, a multiple of that alignment, so a mapped file can be
+// read in place. All header fields are in the byte order of the writer;
+// byte_order holds 0x01020304 written that way.
+struct S21MatrixFileHeader {
+  char magic[8];
+  uint32_t version;
+  // 1 float, 2 double, 3 long double, 4 std::complex<double>.
+  uint32_t dtype;
+  uint32_t element_size;
+  uint32_t byte_order;
+  uint64_t rows;
+  uint64_t cols;
+  // Elements per row, padding included.
+  uint64_t stride;
+  uint64_t alignment;
+  uint64_t data_offset;
+};
+static_assert(sizeof(S21MatrixFileHeader) == 64,
+              "The file header must stay 64 bytes.");
+
+// Streams a rows x cols matrix to a file one row (or block of rows) at a
+// time, so a matrix never has to be in memory as a whole to be saved.
+// Close() reports a short or failed write; the destructor only closes.
+template <typename T>
+class S21BasicMatrixWriter {
+ private:
+  std::ofstream file_;
+  int rows_, cols_, stride_, rows_written_;
+
+ public:
+  static constexpr uint32_t kVersion = 1;
+
+  S21BasicMatrixWriter(const std::string &path, int rows, int cols);
+  S21BasicMatrixWriter(const S21BasicMatrixWriter &) = delete;
+  S21BasicMatrixWriter &operator=(const S21BasicMatrixWriter &) = delete;
+
+  int get_rows_written() const;
+  // Appends the next row: get_cols() elements from `row`.
+  void WriteRow(const T *row);
+  // Appends every row of `rows`, which must have the columns of the file.
+  void WriteRows(S21BasicMatrixView<const T> rows);
+  // Throws when fewer rows than declared were written or the stream failed.
+  void Close();
+
+  static void Save(const S21BasicMatrix<T> &matrix, const std::string &path);
+};
+
+// Read-only matrix backed by a memory-mapped file written by
+// S21BasicMatrixWriter. Opening only validates the header: pages are read
+// in on first touch and shared with the page cache, so the cost follows
+// the elements accessed rather than the file size. The elements are
+// reached through View(), an expression operand like any matrix view;
+// S21BasicMatrix<T>(mapped.View()) makes an owned copy.
+template <typename T>
+class S21BasicMappedMatrix {
+ private:
+  void *mapping_;
+  size_t mapping_size_;
+  const T *data_;
+  int rows_, cols_, stride_;
+
+  void Unmap();
+
+ public:
+  explicit S21BasicMappedMatrix(const std::string &path);
+  S21BasicMappedMatrix(S21BasicMappedMatrix &&other) noexcept;
+  S21BasicMappedMatrix &operator=(S21BasicMappedMatrix &&other) noexcept;
+  S21BasicMappedMatrix(const S21BasicMappedMatrix &) = delete;
+  S21BasicMappedMatrix &operator=(const S21BasicMappedMatrix &) = delete;
+  ~S21BasicMappedMatrix();
+
+  int get_rows() const;
+  int get_cols() const;
+  int get_stride() const;
+  const T *data() const;
+  T operator()(int row, int col) const;
+  // Valid while *this is alive.
+  S21BasicMatrixView<const T> View() const;
+};
+
+using S21MatrixWriter = S21BasicMatrixWriter<double>;
+using S21MappedMatrix = S21BasicMappedMatrix<double>;
+
+extern template class S21BasicMatrixWriter<float>;
+extern template class S21BasicMatrixWriter<double>;
+extern template class S21BasicMatrixWriter<long double>;
+extern template class S21BasicMatrixWriter<std::complex<double>>;
+extern template class S21BasicMappedMatrix<float>;
+extern template class S21BasicMappedMatrix<double>;
+extern template class S21BasicMappedMatrix<long double>;
+extern template class S21BasicMappedMatrix<std::complex<double>>;
+
+#endif  // S21_MATRIX_IO
@@ -0,0 +1,147 @@
+#include "s21_matrix_lu.h"
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_gemm.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Width of the column panels factorized between two GEMM trailing updates.
+constexpr int kPanel = 64;
+}  // namespace
+
+template <typename T>
+S21BasicLUDecomposition<T>::S21BasicLUDecomposition(
+    const S21BasicMatrix<T> &matrix)
+    : lu_(matrix), sign_(1), singular_(false) {
+  lu_.isCorrect(lu_);
+  if (lu_.rows_ != lu_.cols_)
+    throw MatrixException(
+        "LUDecomposition: Matrix must be square to be factorized.");
+  Factorize();
+}
+
+// Right-looking blocked LU. Each panel of kPanel columns is factorized with
+// row-wise eliminations, the matching block row of U is solved against the
+// panel's unit L, and the trailing matrix is updated with one GEMM.
+template <typename T>
+void S21BasicLUDecomposition<T>::Factorize() {
+  const int n = lu_.rows_;
+  const size_t lda = lu_.stride_;
+  T *a = lu_.matrix_.data();
+  perm_.resize(n);
+  for (int i = 0; i < n; ++i) perm_[i] = i;
+
+  for (int kb = 0; kb < n; kb += kPanel) {
+    const int end = std::min(kb + kPanel, n);
+    for (int k = kb; k < end; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < n; ++i)
+        if (std::abs(a[i * lda + k]) > std::abs(a[pivot * lda + k])) pivot = i;
+      if (pivot != k) {
+        std::swap_ranges(a + k * lda, a + k * lda + n, a + pivot * lda);
+        std::swap(perm_[k], perm_[pivot]);
+        sign_ = -sign_;
+      }
+      const T *row_k = a + k * lda;
+      if (row_k[k] == T(0)) {
+        singular_ = true;
+        continue;
+      }
+      for (int i = k + 1; i < n; ++i) {
+        T *row_i = a + i * lda;
+        const T l = row_i[k] /= row_k[k];
+        for (int j = k + 1; j < end; ++j) row_i[j] -= l * row_k[j];
+      }
+    }
+    if (end == n) break;
+    // U12 = L11^-1 * A12.
+    for (int k = kb; k < end; ++k) {
+      const T *row_k = a + k * lda;
+      for (int i = k + 1; i < end; ++i) {
+        T *row_i = a + i * lda;
+        const T l = row_i[k];
+        for (int j = end; j < n; ++j) row_i[j] -= l * row_k[j];
+      }
+    }
+    // A22 -= L21 * U12.
+    s21::Gemm(n - end, n - end, end - kb, T(-1), a + end * lda + kb, lda,
+              a + kb * lda + end, lda, a + end * lda + end, lda, true);
+  }
+}
+
+template <typename T>
+int S21BasicLUDecomposition<T>::get_size() const { return lu_.rows_; }
+
+template <typename T>
+const S21BasicMatrix<T> &S21BasicLUDecomposition<T>::get_lu() const {
+  return lu_;
+}
+
+template <typename T>
+const std::vector<int> &S21BasicLUDecomposition<T>::get_permutation() const {
+  return perm_;
+}
+
+template <typename T>
+bool S21BasicLUDecomposition<T>::IsSingular() const { return singular_; }
+
+template <typename T>
+T S21BasicLUDecomposition<T>::Determinant() const {
+  T result = T(sign_);
+  for (int i = 0; i < lu_.rows_; ++i) result *= lu_.matrix_[lu_.Offset(i, i)];
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLUDecomposition<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  if (b.rows_ != lu_.rows_)
+    throw MatrixException(
+        "Solve: Right-hand side rows do not match the matrix size.");
+  if (singular_) throw MatrixException("Solve: Matrix is singular.");
+  const int n = lu_.rows_;
+  const int m = b.cols_;
+  S21BasicMatrix<T> x(n, m);
+  for (int i = 0; i < n; ++i)
+    std::copy(b.matrix_.data() + b.Offset(perm_[i], 0),
+              b.matrix_.data() + b.Offset(perm_[i], m),
+              x.matrix_.data() + x.Offset(i, 0));
+  // Right-hand side columns are independent, so they are split between
+  // the threads; each range is substituted a whole row slice at a time.
+  S21ThreadPool::ForRange(
+      m, static_cast<size_t>(n) * m, [&](int64_t j0, int64_t j1) {
+        // Forward substitution with the unit lower factor.
+        for (int i = 1; i < n; ++i) {
+          const T *l = lu_.matrix_.data() + lu_.Offset(i, 0);
+          T *xi = x.matrix_.data() + x.Offset(i, 0);
+          for (int k = 0; k < i; ++k) {
+            const T *xk = x.matrix_.data() + x.Offset(k, 0);
+            for (int64_t j = j0; j < j1; ++j) xi[j] -= l[k] * xk[j];
+          }
+        }
+        // Back substitution with the upper factor.
+        for (int i = n - 1; i >= 0; --i) {
+          const T *u = lu_.matrix_.data() + lu_.Offset(i, 0);
+          T *xi = x.matrix_.data() + x.Offset(i, 0);
+          for (int k = i + 1; k < n; ++k) {
+            const T *xk = x.matrix_.data() + x.Offset(k, 0);
+            for (int64_t j = j0; j < j1; ++j) xi[j] -= u[k] * xk[j];
+          }
+          for (int64_t j = j0; j < j1; ++j) xi[j] /= u[i];
+        }
+      });
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLUDecomposition<T>::Inverse() const {
+  const int n = lu_.rows_;
+  S21BasicMatrix<T> identity(n, n);
+  for (int i = 0; i < n; ++i) identity.matrix_[identity.Offset(i, i)] = T(1);
+  return Solve(identity);
+}
+
+template class S21BasicLUDecomposition<float>;
+template class S21BasicLUDecomposition<double>;
+template class S21BasicLUDecomposition<long double>;
+template class S21BasicLUDecomposition<std::complex<double>>;
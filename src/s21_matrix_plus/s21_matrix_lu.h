@@ -0,0 +1,43 @@
+#ifndef S21_MATRIX_LU
+#define S21_MATRIX_LU
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting, P * A = L * U.
+// L (unit lower, diagonal not stored) and U are packed into one matrix and
+// the row permutation is kept as a vector: perm[i] is the row of A that
+// ended up in row i. Factor once, then reuse for determinants, solves and
+// inverses. Instantiated for the same element types as S21BasicMatrix.
+template <typename T>
+class S21BasicLUDecomposition {
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> perm_;
+  int sign_;
+  bool singular_;
+
+  void Factorize();
+
+ public:
+  explicit S21BasicLUDecomposition(const S21BasicMatrix<T> &matrix);
+
+  int get_size() const;
+  const S21BasicMatrix<T> &get_lu() const;
+  const std::vector<int> &get_permutation() const;
+
+  bool IsSingular() const;
+  T Determinant() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  S21BasicMatrix<T> Inverse() const;
+};
+
+using S21LUDecomposition = S21BasicLUDecomposition<double>;
+
+extern template class S21BasicLUDecomposition<float>;
+extern template class S21BasicLUDecomposition<double>;
+extern template class S21BasicLUDecomposition<long double>;
+extern template class S21BasicLUDecomposition<std::complex<double>>;
+
+#endif  // S21_MATRIX_LU
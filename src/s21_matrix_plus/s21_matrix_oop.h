@@ -1,60 +1,340 @@
 #ifndef S21_MATRIX_PLUS
 #define S21_MATRIX_PLUS
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <complex>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
-#define EPS 1e-07
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_traits.h"
+#include "s21_matrix_view.h"
+#include "s21_thread_pool.h"
+
+// Element access policies of S21Matrix::at(). The default one is used by
+// operator() and row(); defining S21_MATRIX_UNCHECKED for the whole build
+// turns those checks off.
+struct S21CheckedAccess {
+  static void Check(bool in_range, const char *message) {
+    if (!in_range) throw MatrixException(message);
+  }
+};
+
+struct S21UncheckedAccess {
+  static void Check(bool, const char *) {}
+};
+
+#ifdef S21_MATRIX_UNCHECKED
+using S21DefaultAccess = S21UncheckedAccess;
+#else
+using S21DefaultAccess = S21CheckedAccess;
+#endif
+
+template <typename T>
+class S21BasicLUDecomposition;
+template <typename T>
+struct S21BasicMatrixCache;
+
+// What S21Matrix::Solve may assume about the matrix. kAuto detects a
+// Hermitian positive definite matrix and takes the Cholesky path for it;
+// kPositiveDefinite skips the detection and throws if the Cholesky
+// factorization fails; kGeneral always uses LU.
+enum class S21SolveHint { kAuto, kGeneral, kPositiveDefinite };
+
+// Product algorithm of MulMatrix. kClassical is the blocked O(n^3) GEMM,
+// kStrassen the Strassen-Winograd recursion of s21_matrix_strassen.h
+// (faster on large products, weaker error bound), kAuto picks Strassen
+// when s21::PreferStrassen() says every dimension is large enough.
+enum class S21MulAlgorithm { kAuto, kClassical, kStrassen };
+
+// Dense matrix of float, double, long double or std::complex<double>
+// elements. The member functions are compiled once into the library for
+// each of those types; S21Matrix is the double one.
+//
+// Every mutator bumps get_version(), and so does every non-const accessor
+// (operator(), at, row, data, the views) once results are cached, since
+// the reference it returns may be written through: read through a const
+// matrix to keep the version. Determinant, InverseMatrix, CalcComplements
+// and NormOne keep the LU factorization, the inverse and the norm they
+// compute until the version changes, so repeated calls on an unchanged
+// matrix reuse them; concurrent calls on one matrix are safe if its memory
+// resource is. The cached matrices come from that resource. The version
+// is atomic, so workers writing different rows of one matrix do not race
+// on it. A pointer or view taken earlier and written through after one of
+// those calls is not seen: take it again, or call ReleaseCache().
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
+  static_assert(S21_MATRIX_ALIGNMENT % sizeof(T) == 0,
+                "Element size must divide the row alignment.");
+
+ public:
+  using value_type = T;
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  // Tolerance EqMatrix compares elements with.
+  static constexpr Real kEpsilon = S21MatrixTraits<T>::kEpsilon;
 
-class S21Matrix {
  private:
-  int rows_, cols_;
-  std::vector<std::vector<double>> matrix_;
+  // Elements are stored row-major in one aligned buffer. Every row starts
+  // on an S21_MATRIX_ALIGNMENT boundary, so stride_ >= cols_ and the padding
+  // tail of each row is kept at zero.
+  int rows_, cols_, stride_;
+  std::vector<T, S21AlignedAllocator<T>> matrix_;
+  std::atomic<uint64_t> version_;
+  // Created by the first cached computation, see S21BasicMatrixCache.
+  mutable std::atomic<S21BasicMatrixCache<T> *> cache_;
+
+  // Reciprocal 1-norm condition number below which an inverse is treated as
+  // numerically singular.
+  static constexpr Real kMinRcond = std::numeric_limits<Real>::epsilon();
+
+  static int StrideFor(int cols);
+  size_t Offset(int row, int col) const {
+    return static_cast<size_t>(row) * stride_ + col;
+  }
+
+  // Evaluates an elementwise expression of the same shape into this
+  // matrix. Reading and writing the same position is safe, so the
+  // expression may refer to *this.
+  // Called by the non-const accessors. Only a matrix with cached results
+  // pays for the increment; relaxed is enough, since writing the elements
+  // already needs the caller's own synchronization.
+  void Touch() {
+    if (cache_.load(std::memory_order_relaxed))
+      version_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template <typename E>
+  void Assign(const E &expr) {
+    ++version_;
+    S21ThreadPool::ForRange(
+        rows_, matrix_.size(), [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            T *row = matrix_.data() + Offset(i, 0);
+            for (int j = 0; j < cols_; ++j) row[j] = expr.Coeff(i, j);
+          }
+        });
+  }
+
+  S21BasicMatrixCache<T> &GetCache() const;
+  std::shared_ptr<const S21BasicLUDecomposition<T>> CachedLU() const;
+  // Null when the matrix is singular.
+  std::shared_ptr<const S21BasicMatrix> CachedInverse(Real *rcond) const;
+
+  friend class S21BasicLUDecomposition<T>;
 
  public:
-  S21Matrix();
-  S21Matrix(int rows, int columns);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other);
-  ~S21Matrix();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int columns);
+  // Storage from `resource` instead of the current S21MatrixResourceScope;
+  // the resource must outlive the matrix.
+  S21BasicMatrix(int rows, int columns, std::pmr::memory_resource *resource);
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E> &expr)
+      : S21BasicMatrix(expr.get_rows(), expr.get_cols()) {
+    Assign(expr.self());
+  }
+  ~S21BasicMatrix();
 
   int get_rows() const;
   int get_cols() const;
+  bool empty() const { return matrix_.empty(); }
   void set_rows(int rows);
   void set_cols(int cols);
-  void set_element(int row, int col, double value);
-  double get_element(int row, int col) const;
+  void set_element(int row, int col, T value);
+  T get_element(int row, int col) const;
+  // Unchecked element read used by expression evaluation.
+  T Coeff(int row, int col) const { return matrix_[Offset(row, col)]; }
+  // A matrix operand only reads the element being written.
+  bool ReadsShifted(const void *, const void *) const { return false; }
+
+  template <typename Access = S21DefaultAccess>
+  T &at(int row, int col) {
+    Access::Check(row >= 0 && row < rows_ && col >= 0 && col < cols_,
+                  "Operator(): Index out of bounds.");
+    Touch();
+    return matrix_[Offset(row, col)];
+  }
+  template <typename Access = S21DefaultAccess>
+  T at(int row, int col) const {
+    Access::Check(row >= 0 && row < rows_ && col >= 0 && col < cols_,
+                  "Operator(): Index out of bounds.");
+    return matrix_[Offset(row, col)];
+  }
+
+  // Raw access for tight loops: rows are get_stride() elements apart and
+  // the first get_cols() of each row are the matrix elements.
+  template <typename Access = S21DefaultAccess>
+  T *row(int i) {
+    Access::Check(i >= 0 && i < rows_, "row: Index out of bounds.");
+    Touch();
+    return matrix_.data() + Offset(i, 0);
+  }
+  template <typename Access = S21DefaultAccess>
+  const T *row(int i) const {
+    Access::Check(i >= 0 && i < rows_, "row: Index out of bounds.");
+    return matrix_.data() + Offset(i, 0);
+  }
+  T *data() {
+    Touch();
+    return matrix_.data();
+  }
+  const T *data() const { return matrix_.data(); }
+  int get_stride() const { return stride_; }
+  std::pmr::memory_resource *get_resource() const {
+    return matrix_.get_allocator().resource();
+  }
+  uint64_t get_version() const {
+    return version_.load(std::memory_order_relaxed);
+  }
+  // Frees the cached results; the next call computes them again.
+  void ReleaseCache() const;
   // void print() const;
 
-  bool EqMatrix(const S21Matrix &other);
-  void SumMatrix(const S21Matrix &other);
-  void SubMatrix(const S21Matrix &other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix &other);
-
-  void isCorrect(const S21Matrix &other);
-
-  void Minor(S21Matrix &minor, int r, int c);
-  double Determinant();
-  S21Matrix CalcComplements();
-  S21Matrix Transpose();
-  S21Matrix InverseMatrix();
-
-  S21Matrix &operator=(S21Matrix &&other);
-  S21Matrix &operator=(const S21Matrix &other);
-  S21Matrix &operator+=(const S21Matrix &other);
-  S21Matrix operator+(const S21Matrix &other);
-  S21Matrix &operator-=(const S21Matrix &other);
-  S21Matrix operator-(const S21Matrix &other);
-  S21Matrix &operator*=(const S21Matrix &other);
-  S21Matrix operator*(const S21Matrix &other);
-  S21Matrix &operator*=(const double num);
-  S21Matrix operator*(const double num);
-  bool operator==(const S21Matrix &other);
-  double &operator()(const int row, const int col);
+  bool EqMatrix(const S21BasicMatrix &other);
+  void SumMatrix(const S21BasicMatrix &other);
+  void SubMatrix(const S21BasicMatrix &other);
+  void MulNumber(const T num);
+  // this += alpha * other in a single fused pass.
+  void Axpy(T alpha, const S21BasicMatrix &other);
+  void MulMatrix(const S21BasicMatrix &other,
+                 S21MulAlgorithm algorithm = S21MulAlgorithm::kAuto);
+
+  void isCorrect(const S21BasicMatrix &other) const;
+
+  void Minor(S21BasicMatrix &minor, int r, int c);
+  T Determinant();
+  S21BasicMatrix CalcComplements();
+  // Cache-oblivious: the matrix is split recursively until the tiles fit
+  // into the cache, whatever its size.
+  S21BasicMatrix Transpose();
+  // Square matrices only; swaps elements without a second buffer.
+  void TransposeInPlace();
+  S21TransposeView<T> TransposedView() const {
+    return S21TransposeView<T>(*this);
+  }
+
+  // Zero-copy views of part of the matrix, see s21_matrix_view.h. A view
+  // of a const matrix is read-only.
+  S21BasicMatrixView<T> Block(int r, int c, int h, int w) {
+    Touch();
+    return S21BasicMatrixView<T>(*this).Block(r, c, h, w);
+  }
+  S21BasicMatrixView<const T> Block(int r, int c, int h, int w) const {
+    return S21BasicMatrixView<const T>(*this).Block(r, c, h, w);
+  }
+  S21BasicMatrixView<T> Row(int i) {
+    Touch();
+    return S21BasicMatrixView<T>(*this).Row(i);
+  }
+  S21BasicMatrixView<const T> Row(int i) const {
+    return S21BasicMatrixView<const T>(*this).Row(i);
+  }
+  S21BasicMatrixView<T> Col(int j) {
+    Touch();
+    return S21BasicMatrixView<T>(*this).Col(j);
+  }
+  S21BasicMatrixView<const T> Col(int j) const {
+    return S21BasicMatrixView<const T>(*this).Col(j);
+  }
+  // Minor(r, c) without copying it.
+  S21MinorView<T> MinorView(int r, int c) const {
+    return S21MinorView<T>(data(), rows_, cols_, stride_, r, c);
+  }
+  S21BasicMatrix InverseMatrix();
+  // x with A * x = b for square A, each column of b a right-hand side.
+  // Factors A without forming the inverse; to solve against many b, keep
+  // an S21BasicLinearSolver (s21_matrix_solve.h) instead.
+  S21BasicMatrix Solve(const S21BasicMatrix &b,
+                       S21SolveHint hint = S21SolveHint::kAuto) const;
+  // x minimizing ||A * x - b|| for A with at least as many rows as
+  // columns, via Householder QR.
+  S21BasicMatrix LeastSquares(const S21BasicMatrix &b) const;
+  Real NormOne() const;
+  Real ReciprocalCondition(const S21BasicMatrix &inverse) const;
+
+  // Takes over the storage of a matrix on the same memory resource and
+  // copies it from any other one, so unlike the move constructor it may
+  // throw.
+  S21BasicMatrix &operator=(S21BasicMatrix &&other);
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  // Keeps the product in a per-thread scratch buffer and swaps it in, so
+  // repeated products of the same shape reuse storage.
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix operator*(const S21BasicMatrix &other) const;
+  S21BasicMatrix &operator*=(const T num);
+
+  // Elementwise +, - and scalar * live in s21_matrix_expr.h and return lazy
+  // expressions; these members evaluate them.
+  template <typename E>
+  S21BasicMatrix &operator=(const S21MatrixExpr<E> &expr) {
+    if (rows_ == expr.get_rows() && cols_ == expr.get_cols() && !empty() &&
+        !expr.ReadsShifted(matrix_.data(),
+                           matrix_.data() + matrix_.size()))
+      Assign(expr.self());
+    else
+      *this = S21BasicMatrix(expr);
+    return *this;
+  }
+  template <typename E>
+  S21BasicMatrix &operator+=(const S21MatrixExpr<E> &expr) {
+    *this = *this + expr;
+    return *this;
+  }
+  template <typename E>
+  S21BasicMatrix &operator-=(const S21MatrixExpr<E> &expr) {
+    *this = *this - expr;
+    return *this;
+  }
+  bool operator==(const S21BasicMatrix &other);
+  T &operator()(int row, int col) { return at(row, col); }
+  T operator()(int row, int col) const { return at(row, col); }
 };
 
+// A temporary left operand is updated in place and becomes the result, so
+// `a * b + c` and `(a * b) * 2.0` do not allocate a second matrix.
+template <typename T, typename R>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs,
+                            const S21MatrixExpr<R> &rhs) {
+  lhs += rhs.self();
+  return std::move(lhs);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs,
+                            const S21MatrixExpr<R> &rhs) {
+  lhs -= rhs.self();
+  return std::move(lhs);
+}
+
+template <typename T, typename S,
+          typename = std::enable_if_t<S21IsScalar<S>::value>>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T> &&lhs, const S &num) {
+  lhs.MulNumber(static_cast<T>(num));
+  return std::move(lhs);
+}
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+using S21MatrixC = S21BasicMatrix<std::complex<double>>;
+
+// Compiled once in s21_matrix.cpp.
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class S21BasicMatrix<std::complex<double>>;
+
 #endif  // S21_MATRIX_PLUS
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "s21_matrix_resource.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+thread_local std::pmr::memory_resource *tls_resource = nullptr;
+
+char *AlignUp(char *p, size_t alignment) {
+  uintptr_t address = reinterpret_cast<uintptr_t>(p);
+  return p + ((alignment - address % alignment) % alignment);
+}
+}  // namespace
+
+S21MatrixResourceScope::S21MatrixResourceScope(
+    std::pmr::memory_resource *resource)
+    : previous_(tls_resource) {
+  tls_resource = resource;
+}
+
+S21MatrixResourceScope::~S21MatrixResourceScope() { tls_resource = previous_; }
+
+std::pmr::memory_resource *S21MatrixResourceScope::Current() {
+  return tls_resource ? tls_resource : std::pmr::get_default_resource();
+}
+
+S21PoolResource::S21PoolResource(size_t max_block,
+                                 std::pmr::memory_resource *upstream)
+    : upstream_(upstream), max_block_(kMinBlock), cached_bytes_(0) {
+  while (max_block_ < max_block) max_block_ *= 2;
+  free_.assign(ClassOf(max_block_, 1) + 1, nullptr);
+}
+
+S21PoolResource::~S21PoolResource() { Release(); }
+
+int S21PoolResource::ClassOf(size_t bytes, size_t alignment) const {
+  if (bytes > max_block_ || alignment > kMinBlock) return -1;
+  int k = 0;
+  for (size_t block = kMinBlock; block < bytes; block *= 2) ++k;
+  return k;
+}
+
+void S21PoolResource::Release() {
+  for (size_t k = 0; k < free_.size(); ++k) {
+    while (FreeBlock *block = free_[k]) {
+      free_[k] = block->next;
+      upstream_->deallocate(block, kMinBlock << k, kMinBlock);
+    }
+  }
+  cached_bytes_ = 0;
+}
+
+size_t S21PoolResource::get_cached_bytes() const { return cached_bytes_; }
+
+void *S21PoolResource::do_allocate(size_t bytes, size_t alignment) {
+  int k = ClassOf(bytes, alignment);
+  if (k < 0) return upstream_->allocate(bytes, alignment);
+  if (FreeBlock *block = free_[k]) {
+    free_[k] = block->next;
+    cached_bytes_ -= kMinBlock << k;
+    return block;
+  }
+  return upstream_->allocate(kMinBlock << k, kMinBlock);
+}
+
+void S21PoolResource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+  int k = ClassOf(bytes, alignment);
+  if (k < 0) return upstream_->deallocate(p, bytes, alignment);
+  FreeBlock *block = static_cast<FreeBlock *>(p);
+  block->next = free_[k];
+  free_[k] = block;
+  cached_bytes_ += kMinBlock << k;
+}
+
+bool S21PoolResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+S21ArenaResource::S21ArenaResource(size_t initial_chunk,
+                                   std::pmr::memory_resource *upstream)
+    : upstream_(upstream),
+      next_chunk_(std::max(initial_chunk, 2 * kHeader)),
+      chunks_(nullptr),
+      cursor_(nullptr),
+      end_(nullptr),
+      used_(0) {}
+
+S21ArenaResource::~S21ArenaResource() { FreeChunks(chunks_); }
+
+void S21ArenaResource::FreeChunks(Chunk *chunk) {
+  while (chunk) {
+    Chunk *next = chunk->next;
+    upstream_->deallocate(chunk, chunk->size, kHeader);
+    chunk = next;
+  }
+}
+
+void S21ArenaResource::Release() {
+  Chunk *largest = chunks_;
+  for (Chunk *c = chunks_; c; c = c->next)
+    if (c->size > largest->size) largest = c;
+  for (Chunk *c = chunks_, *next; c; c = next) {
+    next = c->next;
+    if (c != largest) upstream_->deallocate(c, c->size, kHeader);
+  }
+  chunks_ = largest;
+  if (largest) {
+    largest->next = nullptr;
+    cursor_ = reinterpret_cast<char *>(largest) + kHeader;
+    end_ = reinterpret_cast<char *>(largest) + largest->size;
+  }
+  used_ = 0;
+}
+
+size_t S21ArenaResource::get_used_bytes() const { return used_; }
+
+size_t S21ArenaResource::get_chunk_count() const {
+  size_t count = 0;
+  for (Chunk *c = chunks_; c; c = c->next) ++count;
+  return count;
+}
+
+void S21ArenaResource::Grow(size_t bytes, size_t alignment) {
+  size_t size = kHeader + bytes + (alignment > kHeader ? alignment : 0);
+  if (size <= next_chunk_) {
+    size = next_chunk_;
+    next_chunk_ *= 2;
+  }
+  Chunk *chunk = static_cast<Chunk *>(upstream_->allocate(size, kHeader));
+  chunk->next = chunks_;
+  chunk->size = size;
+  chunks_ = chunk;
+  cursor_ = reinterpret_cast<char *>(chunk) + kHeader;
+  end_ = reinterpret_cast<char *>(chunk) + size;
+}
+
+void *S21ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+  char *p = cursor_ ? AlignUp(cursor_, alignment) : nullptr;
+  if (!p || p > end_ || static_cast<size_t>(end_ - p) < bytes) {
+    Grow(bytes, alignment);
+    p = AlignUp(cursor_, alignment);
+  }
+  cursor_ = p + bytes;
+  used_ += bytes;
+  return p;
+}
+
+void S21ArenaResource::do_deallocate(void *, size_t, size_t) {}
+
+bool S21ArenaResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
@@ -0,0 +1,117 @@
+#ifndef S21_MATRIX_RESOURCE
+#define S21_MATRIX_RESOURCE
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Memory resources for matrix storage. A matrix allocates from the
+// resource installed by the innermost S21MatrixResourceScope of the thread
+// that creates it, or from std::pmr::get_default_resource() outside any
+// scope, and keeps using that resource for its whole life. Matrices must
+// therefore not outlive the resource they were created on.
+//
+//   S21ArenaResource arena;
+//   {
+//     S21MatrixResourceScope scope(&arena);
+//     S21Matrix result = HandleRequest(...);  // temporaries in the arena
+//     Reply(result);
+//   }
+//   arena.Release();  // all of it at once
+class S21MatrixResourceScope {
+ public:
+  explicit S21MatrixResourceScope(std::pmr::memory_resource *resource);
+  S21MatrixResourceScope(const S21MatrixResourceScope &) = delete;
+  S21MatrixResourceScope &operator=(const S21MatrixResourceScope &) = delete;
+  ~S21MatrixResourceScope();
+
+  static std::pmr::memory_resource *Current();
+
+ private:
+  std::pmr::memory_resource *previous_;
+};
+
+// Recycles freed blocks by size class. Requests up to max_block bytes are
+// rounded up to a power of two of at least 64 bytes; a freed block goes to
+// the free list of its class and serves the next request of that class,
+// so a steady stream of same-shaped temporaries stops reaching upstream.
+// Larger or over-aligned requests go straight upstream. Not thread-safe:
+// use one pool per thread, as with std::pmr::unsynchronized_pool_resource.
+class S21PoolResource : public std::pmr::memory_resource {
+ public:
+  static constexpr size_t kMinBlock = 64;
+
+  explicit S21PoolResource(
+      size_t max_block = size_t(1) << 22,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  S21PoolResource(const S21PoolResource &) = delete;
+  S21PoolResource &operator=(const S21PoolResource &) = delete;
+  ~S21PoolResource() override;
+
+  // Returns the cached free blocks upstream.
+  void Release();
+  size_t get_cached_bytes() const;
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  std::pmr::memory_resource *upstream_;
+  size_t max_block_;
+  size_t cached_bytes_;
+  // free_[k] holds blocks of kMinBlock << k bytes.
+  std::vector<FreeBlock *> free_;
+
+  // Size class of a pooled request, or -1 when it bypasses the pool.
+  int ClassOf(size_t bytes, size_t alignment) const;
+
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override;
+};
+
+// Monotonic arena: allocation bumps a pointer through chunks taken from
+// upstream, each twice the size of the previous one, and deallocation does
+// nothing. Release() frees everything allocated so far at once; it keeps
+// the largest chunk, so an arena reused per request settles to one chunk
+// and no upstream calls. Not thread-safe.
+class S21ArenaResource : public std::pmr::memory_resource {
+ public:
+  explicit S21ArenaResource(
+      size_t initial_chunk = size_t(1) << 16,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  S21ArenaResource(const S21ArenaResource &) = delete;
+  S21ArenaResource &operator=(const S21ArenaResource &) = delete;
+  ~S21ArenaResource() override;
+
+  void Release();
+  // Bytes handed out since construction or the last Release().
+  size_t get_used_bytes() const;
+  size_t get_chunk_count() const;
+
+ private:
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+  };
+  // Chunk headers take one alignment unit, keeping the payload aligned.
+  static constexpr size_t kHeader = 64;
+
+  std::pmr::memory_resource *upstream_;
+  size_t next_chunk_;
+  Chunk *chunks_;
+  char *cursor_, *end_;
+  size_t used_;
+
+  void Grow(size_t bytes, size_t alignment);
+  void FreeChunks(Chunk *chunk);
+
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override;
+};
+
+#endif  // S21_MATRIX_RESOURCE
@@ -0,0 +1,482 @@
+#include "s21_matrix_simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_MATRIX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+// How many elements EqMatrix kernels compare between two early-exit checks.
+constexpr size_t kEqualBlock = 64;
+
+template <typename T>
+using Real = typename S21MatrixTraits<T>::Real;
+
+template <typename T>
+void AddScalar(T *dst, const T *src, size_t n) {
+  for (size_t k = 0; k < n; ++k) dst[k] += src[k];
+}
+
+template <typename T>
+void SubScalar(T *dst, const T *src, size_t n) {
+  for (size_t k = 0; k < n; ++k) dst[k] -= src[k];
+}
+
+template <typename T>
+void ScaleScalar(T *dst, T alpha, size_t n) {
+  for (size_t k = 0; k < n; ++k) dst[k] *= alpha;
+}
+
+template <typename T>
+void AxpyScalar(T *dst, T alpha, const T *src, size_t n) {
+  for (size_t k = 0; k < n; ++k) dst[k] += alpha * src[k];
+}
+
+template <typename T>
+bool EqualScalar(const T *a, const T *b, size_t n, Real<T> eps) {
+  bool equal = true;
+  for (size_t k = 0; k < n; ++k) equal &= !(std::abs(a[k] - b[k]) > eps);
+  return equal;
+}
+
+#ifdef S21_MATRIX_X86
+
+// SSE2 is part of the x86-64 baseline, so these need no target attribute.
+
+void AddSse2(double *dst, const double *src, size_t n) {
+  size_t k = 0;
+  for (; k + 2 <= n; k += 2)
+    _mm_storeu_pd(dst + k,
+                  _mm_add_pd(_mm_loadu_pd(dst + k), _mm_loadu_pd(src + k)));
+  AddScalar(dst + k, src + k, n - k);
+}
+
+void SubSse2(double *dst, const double *src, size_t n) {
+  size_t k = 0;
+  for (; k + 2 <= n; k += 2)
+    _mm_storeu_pd(dst + k,
+                  _mm_sub_pd(_mm_loadu_pd(dst + k), _mm_loadu_pd(src + k)));
+  SubScalar(dst + k, src + k, n - k);
+}
+
+void ScaleSse2(double *dst, double alpha, size_t n) {
+  const __m128d a = _mm_set1_pd(alpha);
+  size_t k = 0;
+  for (; k + 2 <= n; k += 2)
+    _mm_storeu_pd(dst + k, _mm_mul_pd(_mm_loadu_pd(dst + k), a));
+  ScaleScalar(dst + k, alpha, n - k);
+}
+
+void AxpySse2(double *dst, double alpha, const double *src, size_t n) {
+  const __m128d a = _mm_set1_pd(alpha);
+  size_t k = 0;
+  for (; k + 2 <= n; k += 2)
+    _mm_storeu_pd(dst + k, _mm_add_pd(_mm_loadu_pd(dst + k),
+                                      _mm_mul_pd(a, _mm_loadu_pd(src + k))));
+  AxpyScalar(dst + k, alpha, src + k, n - k);
+}
+
+bool EqualSse2(const double *a, const double *b, size_t n, double eps) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d limit = _mm_set1_pd(eps);
+  size_t k = 0;
+  while (k + 2 <= n) {
+    __m128d differ = _mm_setzero_pd();
+    size_t stop = std::min(n & ~size_t(1), k + kEqualBlock);
+    for (; k < stop; k += 2) {
+      __m128d d = _mm_sub_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k));
+      differ = _mm_or_pd(differ, _mm_cmpgt_pd(_mm_andnot_pd(sign, d), limit));
+    }
+    if (_mm_movemask_pd(differ)) return false;
+  }
+  return EqualScalar(a + k, b + k, n - k, eps);
+}
+
+__attribute__((target("avx2,fma"))) void AddAvx2(double *dst,
+                                                  const double *src,
+                                                  size_t n) {
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm256_storeu_pd(dst + k, _mm256_add_pd(_mm256_loadu_pd(dst + k),
+                                            _mm256_loadu_pd(src + k)));
+  AddScalar(dst + k, src + k, n - k);
+}
+
+__attribute__((target("avx2,fma"))) void SubAvx2(double *dst,
+                                                  const double *src,
+                                                  size_t n) {
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm256_storeu_pd(dst + k, _mm256_sub_pd(_mm256_loadu_pd(dst + k),
+                                            _mm256_loadu_pd(src + k)));
+  SubScalar(dst + k, src + k, n - k);
+}
+
+__attribute__((target("avx2,fma"))) void ScaleAvx2(double *dst, double alpha,
+                                                    size_t n) {
+  const __m256d a = _mm256_set1_pd(alpha);
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm256_storeu_pd(dst + k, _mm256_mul_pd(_mm256_loadu_pd(dst + k), a));
+  ScaleScalar(dst + k, alpha, n - k);
+}
+
+__attribute__((target("avx2,fma"))) void AxpyAvx2(double *dst, double alpha,
+                                                   const double *src,
+                                                   size_t n) {
+  const __m256d a = _mm256_set1_pd(alpha);
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm256_storeu_pd(dst + k, _mm256_fmadd_pd(a, _mm256_loadu_pd(src + k),
+                                              _mm256_loadu_pd(dst + k)));
+  AxpyScalar(dst + k, alpha, src + k, n - k);
+}
+
+__attribute__((target("avx2,fma"))) bool EqualAvx2(const double *a,
+                                                    const double *b, size_t n,
+                                                    double eps) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(eps);
+  size_t k = 0;
+  while (k + 4 <= n) {
+    __m256d differ = _mm256_setzero_pd();
+    size_t stop = std::min(n & ~size_t(3), k + kEqualBlock);
+    for (; k < stop; k += 4) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k));
+      differ = _mm256_or_pd(
+          differ,
+          _mm256_cmp_pd(_mm256_andnot_pd(sign, d), limit, _CMP_GT_OQ));
+    }
+    if (_mm256_movemask_pd(differ)) return false;
+  }
+  return EqualScalar(a + k, b + k, n - k, eps);
+}
+
+// AVX-512 handles the tail with masked loads and stores instead of a
+// scalar loop.
+
+__attribute__((target("avx512f"))) void AddAvx512(double *dst,
+                                                   const double *src,
+                                                   size_t n) {
+  for (size_t k = 0; k < n; k += 8) {
+    __mmask8 m = n - k >= 8 ? 0xFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_pd(dst + k, m,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(m, dst + k),
+                                        _mm512_maskz_loadu_pd(m, src + k)));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double *dst,
+                                                   const double *src,
+                                                   size_t n) {
+  for (size_t k = 0; k < n; k += 8) {
+    __mmask8 m = n - k >= 8 ? 0xFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_pd(dst + k, m,
+                          _mm512_sub_pd(_mm512_maskz_loadu_pd(m, dst + k),
+                                        _mm512_maskz_loadu_pd(m, src + k)));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double *dst, double alpha,
+                                                     size_t n) {
+  const __m512d a = _mm512_set1_pd(alpha);
+  for (size_t k = 0; k < n; k += 8) {
+    __mmask8 m = n - k >= 8 ? 0xFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_pd(dst + k, m,
+                          _mm512_mul_pd(_mm512_maskz_loadu_pd(m, dst + k), a));
+  }
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(double *dst, double alpha,
+                                                    const double *src,
+                                                    size_t n) {
+  const __m512d a = _mm512_set1_pd(alpha);
+  for (size_t k = 0; k < n; k += 8) {
+    __mmask8 m = n - k >= 8 ? 0xFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_pd(
+        dst + k, m,
+        _mm512_fmadd_pd(a, _mm512_maskz_loadu_pd(m, src + k),
+                        _mm512_maskz_loadu_pd(m, dst + k)));
+  }
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double *a,
+                                                     const double *b, size_t n,
+                                                     double eps) {
+  const __m512d limit = _mm512_set1_pd(eps);
+  for (size_t k = 0; k < n;) {
+    __mmask8 differ = 0;
+    size_t stop = std::min(n, k + kEqualBlock);
+    for (; k < stop; k += 8) {
+      __mmask8 m = stop - k >= 8 ? 0xFF : (1u << (stop - k)) - 1;
+      __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(m, a + k),
+                                _mm512_maskz_loadu_pd(m, b + k));
+      differ |= _mm512_cmp_pd_mask(_mm512_abs_pd(d), limit, _CMP_GT_OQ);
+    }
+    if (differ) return false;
+  }
+  return true;
+}
+
+// float kernels: the same shapes with twice as many lanes per vector.
+
+void AddSse2(float *dst, const float *src, size_t n) {
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm_storeu_ps(dst + k,
+                  _mm_add_ps(_mm_loadu_ps(dst + k), _mm_loadu_ps(src + k)));
+  AddScalar(dst + k, src + k, n - k);
+}
+
+void SubSse2(float *dst, const float *src, size_t n) {
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm_storeu_ps(dst + k,
+                  _mm_sub_ps(_mm_loadu_ps(dst + k), _mm_loadu_ps(src + k)));
+  SubScalar(dst + k, src + k, n - k);
+}
+
+void ScaleSse2(float *dst, float alpha, size_t n) {
+  const __m128 a = _mm_set1_ps(alpha);
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm_storeu_ps(dst + k, _mm_mul_ps(_mm_loadu_ps(dst + k), a));
+  ScaleScalar(dst + k, alpha, n - k);
+}
+
+void AxpySse2(float *dst, float alpha, const float *src, size_t n) {
+  const __m128 a = _mm_set1_ps(alpha);
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    _mm_storeu_ps(dst + k, _mm_add_ps(_mm_loadu_ps(dst + k),
+                                      _mm_mul_ps(a, _mm_loadu_ps(src + k))));
+  AxpyScalar(dst + k, alpha, src + k, n - k);
+}
+
+bool EqualSse2(const float *a, const float *b, size_t n, float eps) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 limit = _mm_set1_ps(eps);
+  size_t k = 0;
+  while (k + 4 <= n) {
+    __m128 differ = _mm_setzero_ps();
+    size_t stop = std::min(n & ~size_t(3), k + kEqualBlock);
+    for (; k < stop; k += 4) {
+      __m128 d = _mm_sub_ps(_mm_loadu_ps(a + k), _mm_loadu_ps(b + k));
+      differ = _mm_or_ps(differ, _mm_cmpgt_ps(_mm_andnot_ps(sign, d), limit));
+    }
+    if (_mm_movemask_ps(differ)) return false;
+  }
+  return EqualScalar(a + k, b + k, n - k, eps);
+}
+
+__attribute__((target("avx2,fma"))) void AddAvx2(float *dst, const float *src,
+                                                  size_t n) {
+  size_t k = 0;
+  for (; k + 8 <= n; k += 8)
+    _mm256_storeu_ps(dst + k, _mm256_add_ps(_mm256_loadu_ps(dst + k),
+                                            _mm256_loadu_ps(src + k)));
+  AddScalar(dst + k, src + k, n - k);
+}
+
+__attribute__((target("avx2,fma"))) void SubAvx2(float *dst, const float *src,
+                                                  size_t n) {
+  size_t k = 0;
+  for (; k + 8 <= n; k += 8)
+    _mm256_storeu_ps(dst + k, _mm256_sub_ps(_mm256_loadu_ps(dst + k),
+                                            _mm256_loadu_ps(src + k)));
+  SubScalar(dst + k, src + k, n - k);
+}
+
+__attribute__((target("avx2,fma"))) void ScaleAvx2(float *dst, float alpha,
+                                                    size_t n) {
+  const __m256 a = _mm256_set1_ps(alpha);
+  size_t k = 0;
+  for (; k + 8 <= n; k += 8)
+    _mm256_storeu_ps(dst + k, _mm256_mul_ps(_mm256_loadu_ps(dst + k), a));
+  ScaleScalar(dst + k, alpha, n - k);
+}
+
+__attribute__((target("avx2,fma"))) void AxpyAvx2(float *dst, float alpha,
+                                                   const float *src,
+                                                   size_t n) {
+  const __m256 a = _mm256_set1_ps(alpha);
+  size_t k = 0;
+  for (; k + 8 <= n; k += 8)
+    _mm256_storeu_ps(dst + k, _mm256_fmadd_ps(a, _mm256_loadu_ps(src + k),
+                                              _mm256_loadu_ps(dst + k)));
+  AxpyScalar(dst + k, alpha, src + k, n - k);
+}
+
+__attribute__((target("avx2,fma"))) bool EqualAvx2(const float *a,
+                                                    const float *b, size_t n,
+                                                    float eps) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 limit = _mm256_set1_ps(eps);
+  size_t k = 0;
+  while (k + 8 <= n) {
+    __m256 differ = _mm256_setzero_ps();
+    size_t stop = std::min(n & ~size_t(7), k + kEqualBlock);
+    for (; k < stop; k += 8) {
+      __m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k));
+      differ = _mm256_or_ps(
+          differ, _mm256_cmp_ps(_mm256_andnot_ps(sign, d), limit, _CMP_GT_OQ));
+    }
+    if (_mm256_movemask_ps(differ)) return false;
+  }
+  return EqualScalar(a + k, b + k, n - k, eps);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(float *dst,
+                                                   const float *src,
+                                                   size_t n) {
+  for (size_t k = 0; k < n; k += 16) {
+    __mmask16 m = n - k >= 16 ? 0xFFFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_ps(dst + k, m,
+                          _mm512_add_ps(_mm512_maskz_loadu_ps(m, dst + k),
+                                        _mm512_maskz_loadu_ps(m, src + k)));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float *dst,
+                                                   const float *src,
+                                                   size_t n) {
+  for (size_t k = 0; k < n; k += 16) {
+    __mmask16 m = n - k >= 16 ? 0xFFFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_ps(dst + k, m,
+                          _mm512_sub_ps(_mm512_maskz_loadu_ps(m, dst + k),
+                                        _mm512_maskz_loadu_ps(m, src + k)));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float *dst, float alpha,
+                                                     size_t n) {
+  const __m512 a = _mm512_set1_ps(alpha);
+  for (size_t k = 0; k < n; k += 16) {
+    __mmask16 m = n - k >= 16 ? 0xFFFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_ps(dst + k, m,
+                          _mm512_mul_ps(_mm512_maskz_loadu_ps(m, dst + k), a));
+  }
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(float *dst, float alpha,
+                                                    const float *src,
+                                                    size_t n) {
+  const __m512 a = _mm512_set1_ps(alpha);
+  for (size_t k = 0; k < n; k += 16) {
+    __mmask16 m = n - k >= 16 ? 0xFFFF : (1u << (n - k)) - 1;
+    _mm512_mask_storeu_ps(
+        dst + k, m,
+        _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(m, src + k),
+                        _mm512_maskz_loadu_ps(m, dst + k)));
+  }
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float *a,
+                                                     const float *b, size_t n,
+                                                     float eps) {
+  const __m512 limit = _mm512_set1_ps(eps);
+  for (size_t k = 0; k < n;) {
+    __mmask16 differ = 0;
+    size_t stop = std::min(n, k + kEqualBlock);
+    for (; k < stop; k += 16) {
+      __mmask16 m = stop - k >= 16 ? 0xFFFF : (1u << (stop - k)) - 1;
+      __m512 d = _mm512_sub_ps(_mm512_maskz_loadu_ps(m, a + k),
+                               _mm512_maskz_loadu_ps(m, b + k));
+      differ |= _mm512_cmp_ps_mask(_mm512_abs_ps(d), limit, _CMP_GT_OQ);
+    }
+    if (differ) return false;
+  }
+  return true;
+}
+
+#endif  // S21_MATRIX_X86
+
+template <typename T>
+constexpr SimdKernels<T> kScalarKernels = {SimdLevel::kScalar, "scalar",
+                                          AddScalar<T>,      SubScalar<T>,
+                                          ScaleScalar<T>,    AxpyScalar<T>,
+                                          EqualScalar<T>};
+
+// Kernels of every level, indexed by SimdLevel. Element types without
+// vector kernels only have the scalar entry.
+template <typename T>
+struct KernelTable {
+  static constexpr SimdKernels<T> kKernels[] = {kScalarKernels<T>};
+};
+
+#ifdef S21_MATRIX_X86
+template <>
+struct KernelTable<double> {
+  static constexpr SimdKernels<double> kKernels[] = {
+      kScalarKernels<double>,
+      {SimdLevel::kSse2, "sse2", AddSse2, SubSse2, ScaleSse2, AxpySse2,
+       EqualSse2},
+      {SimdLevel::kAvx2, "avx2", AddAvx2, SubAvx2, ScaleAvx2, AxpyAvx2,
+       EqualAvx2},
+      {SimdLevel::kAvx512, "avx512", AddAvx512, SubAvx512, ScaleAvx512,
+       AxpyAvx512, EqualAvx512},
+  };
+};
+
+template <>
+struct KernelTable<float> {
+  static constexpr SimdKernels<float> kKernels[] = {
+      kScalarKernels<float>,
+      {SimdLevel::kSse2, "sse2", AddSse2, SubSse2, ScaleSse2, AxpySse2,
+       EqualSse2},
+      {SimdLevel::kAvx2, "avx2", AddAvx2, SubAvx2, ScaleAvx2, AxpyAvx2,
+       EqualAvx2},
+      {SimdLevel::kAvx512, "avx512", AddAvx512, SubAvx512, ScaleAvx512,
+       AxpyAvx512, EqualAvx512},
+  };
+};
+#endif
+
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#ifdef S21_MATRIX_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return SimdLevel::kAvx2;
+  if (__builtin_cpu_supports("sse2")) return SimdLevel::kSse2;
+#endif
+  return SimdLevel::kScalar;
+}
+
+template <typename T>
+const SimdKernels<T> &SimdKernelsFor(SimdLevel level) {
+  const auto &table = KernelTable<T>::kKernels;
+  int index = std::min(static_cast<int>(std::min(level, DetectSimdLevel())),
+                       static_cast<int>(std::size(table)) - 1);
+  return table[index];
+}
+
+template <typename T>
+const SimdKernels<T> &Simd() {
+  static const SimdKernels<T> &kernels = SimdKernelsFor<T>(DetectSimdLevel());
+  return kernels;
+}
+
+template const SimdKernels<float> &SimdKernelsFor<float>(SimdLevel);
+template const SimdKernels<double> &SimdKernelsFor<double>(SimdLevel);
+template const SimdKernels<long double> &SimdKernelsFor<long double>(
+    SimdLevel);
+template const SimdKernels<std::complex<double>> &
+SimdKernelsFor<std::complex<double>>(SimdLevel);
+template const SimdKernels<float> &Simd<float>();
+template const SimdKernels<double> &Simd<double>();
+template const SimdKernels<long double> &Simd<long double>();
+template const SimdKernels<std::complex<double>> &
+Simd<std::complex<double>>();
+
+}  // namespace s21
@@ -0,0 +1,43 @@
+#ifndef S21_MATRIX_SIMD
+#define S21_MATRIX_SIMD
+
+#include <cstddef>
+
+#include "s21_matrix_traits.h"
+
+namespace s21 {
+
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Elementwise kernels over n contiguous elements. Pointers need no
+// particular alignment. float and double have vector kernels at every
+// level; the other element types only have scalar ones.
+template <typename T>
+struct SimdKernels {
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  SimdLevel level;
+  const char *name;
+  void (*add)(T *dst, const T *src, size_t n);
+  void (*sub)(T *dst, const T *src, size_t n);
+  void (*scale)(T *dst, T alpha, size_t n);
+  // dst += alpha * src, fused multiply-add where the ISA has it.
+  void (*axpy)(T *dst, T alpha, const T *src, size_t n);
+  // True when |a[k] - b[k]| <= eps for every k (NaN compares equal, as in
+  // the scalar EqMatrix it replaces).
+  bool (*equal)(const T *a, const T *b, size_t n, Real eps);
+};
+
+// Best level supported by this CPU, queried through CPUID once.
+SimdLevel DetectSimdLevel();
+// Kernels of a given level; levels the CPU or the element type lacks fall
+// back to the best supported one below them.
+template <typename T = double>
+const SimdKernels<T> &SimdKernelsFor(SimdLevel level);
+// Kernels of DetectSimdLevel(), selected on first use.
+template <typename T = double>
+const SimdKernels<T> &Simd();
+
+}  // namespace s21
+
+#endif  // S21_MATRIX_SIMD
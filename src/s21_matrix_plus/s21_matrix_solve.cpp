@@ -0,0 +1,362 @@
+#include "s21_matrix_solve.h"
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_gemm.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Width of the column panels factorized between two GEMM trailing updates.
+constexpr int kPanel = 64;
+// Relative difference between a(i, j) and conj(a(j, i)) still taken for
+// Hermitian, in units of machine epsilon: products like A^H * A computed
+// in a different summation order differ by a few ulps.
+constexpr int kSymmetryUlps = 64;
+// Side of the tiles the symmetry check compares against their transpose.
+constexpr int kSymmetryTile = 32;
+
+template <typename T>
+T Conj(const T &x) {
+  return x;
+}
+
+template <typename T>
+std::complex<T> Conj(const std::complex<T> &x) {
+  return std::conj(x);
+}
+}  // namespace
+
+template <typename T>
+S21BasicCholeskyDecomposition<T>::S21BasicCholeskyDecomposition(
+    const S21BasicMatrix<T> &matrix)
+    : l_(matrix), positive_definite_(true) {
+  l_.isCorrect(l_);
+  if (l_.get_rows() != l_.get_cols())
+    throw MatrixException(
+        "CholeskyDecomposition: Matrix must be square to be factorized.");
+  Factorize();
+}
+
+// Right-looking blocked Cholesky. Within a panel of kPanel columns each
+// finished column is scaled by its diagonal and subtracted from the rest
+// of the panel, row by row, so the inner loops are contiguous row slices
+// and the rows split between the threads. The trailing lower triangle is
+// then updated with L21 * L21^H one block row at a time, so GEMM skips the
+// upper half.
+template <typename T>
+void S21BasicCholeskyDecomposition<T>::Factorize() {
+  using Real = typename S21MatrixTraits<T>::Real;
+  const int n = l_.get_rows();
+  const size_t lda = l_.get_stride();
+  T *a = l_.data();
+  std::vector<T> panel_h, column(kPanel);
+  for (int kb = 0; kb < n && positive_definite_; kb += kPanel) {
+    const int end = std::min(kb + kPanel, n);
+    for (int j = kb; j < end; ++j) {
+      const Real d = std::real(a[j * lda + j]);
+      if (!(d > Real(0))) {
+        positive_definite_ = false;
+        break;
+      }
+      const Real diagonal = std::sqrt(d);
+      a[j * lda + j] = T(diagonal);
+      for (int c = j + 1; c < end; ++c)
+        column[c - j - 1] = Conj(a[c * lda + j] /= diagonal);
+      S21ThreadPool::ForRange(
+          n - j - 1, static_cast<size_t>(n - j) * (end - j),
+          [&](int64_t begin, int64_t stop) {
+            for (int64_t i = j + 1 + begin; i < j + 1 + stop; ++i) {
+              T *row_i = a + i * lda;
+              if (i >= end) row_i[j] /= diagonal;
+              const T l = row_i[j];
+              for (int c = j + 1; c < end; ++c)
+                row_i[c] -= l * column[c - j - 1];
+            }
+          });
+    }
+    if (end == n || !positive_definite_) continue;
+    // L21^H, packed row-major: panel_h[k * rest + i] = conj(L21(i, k)).
+    const int width = end - kb, rest = n - end;
+    panel_h.resize(static_cast<size_t>(width) * rest);
+    for (int i = 0; i < rest; ++i)
+      for (int k = 0; k < width; ++k)
+        panel_h[k * rest + i] = Conj(a[(end + i) * lda + kb + k]);
+    // A22 -= L21 * L21^H, lower triangle by block rows.
+    for (int rb = end; rb < n; rb += kPanel) {
+      const int rend = std::min(rb + kPanel, n);
+      s21::Gemm(rend - rb, rend - end, width, T(-1), a + rb * lda + kb, lda,
+                panel_h.data(), rest, a + rb * lda + end, lda, true);
+    }
+  }
+  for (int i = 0; i < n; ++i)
+    std::fill(a + i * lda + i + 1, a + i * lda + n, T(0));
+}
+
+template <typename T>
+int S21BasicCholeskyDecomposition<T>::get_size() const {
+  return l_.get_rows();
+}
+
+template <typename T>
+const S21BasicMatrix<T> &S21BasicCholeskyDecomposition<T>::get_l() const {
+  return l_;
+}
+
+template <typename T>
+bool S21BasicCholeskyDecomposition<T>::IsPositiveDefinite() const {
+  return positive_definite_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholeskyDecomposition<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  if (b.get_rows() != l_.get_rows())
+    throw MatrixException(
+        "Solve: Right-hand side rows do not match the matrix size.");
+  if (!positive_definite_)
+    throw MatrixException("Solve: Matrix is not positive definite.");
+  const int n = l_.get_rows();
+  const int m = b.get_cols();
+  S21BasicMatrix<T> x(b);
+  const T *l0 = l_.data();
+  T *x0 = x.data();
+  const size_t ldl = l_.get_stride(), ldx = x.get_stride();
+  S21ThreadPool::ForRange(
+      m, static_cast<size_t>(n) * m, [&](int64_t j0, int64_t j1) {
+        // L * y = b, forward.
+        for (int i = 0; i < n; ++i) {
+          const T *l = l0 + i * ldl;
+          T *xi = x0 + i * ldx;
+          for (int k = 0; k < i; ++k) {
+            const T *xk = x0 + k * ldx;
+            for (int64_t j = j0; j < j1; ++j) xi[j] -= l[k] * xk[j];
+          }
+          for (int64_t j = j0; j < j1; ++j) xi[j] /= l[i];
+        }
+        // L^H * x = y, backward. Row i of L is column i of L^H, so each
+        // solved row is subtracted from the rows above it.
+        for (int i = n - 1; i >= 0; --i) {
+          const T *l = l0 + i * ldl;
+          T *xi = x0 + i * ldx;
+          for (int64_t j = j0; j < j1; ++j) xi[j] /= l[i];
+          for (int k = 0; k < i; ++k) {
+            const T lk = Conj(l[k]);
+            T *xk = x0 + k * ldx;
+            for (int64_t j = j0; j < j1; ++j) xk[j] -= lk * xi[j];
+          }
+        }
+      });
+  return x;
+}
+
+template <typename T>
+S21BasicQRDecomposition<T>::S21BasicQRDecomposition(
+    const S21BasicMatrix<T> &matrix)
+    : qr_(matrix), rank_deficient_(false) {
+  qr_.isCorrect(qr_);
+  if (qr_.get_rows() < qr_.get_cols())
+    throw MatrixException(
+        "QRDecomposition: Matrix must have at least as many rows as "
+        "columns.");
+  Factorize();
+}
+
+// Column k is reflected onto alpha * e_k with |alpha| = ||column||, the
+// phase of alpha opposite to the diagonal element so that v = x - alpha
+// * e_k does not cancel. v is scaled to v_k = 1 and H = I - tau v v^H.
+template <typename T>
+void S21BasicQRDecomposition<T>::Factorize() {
+  using Real = typename S21MatrixTraits<T>::Real;
+  const int m = qr_.get_rows();
+  const int n = qr_.get_cols();
+  tau_.assign(n, T(0));
+  Real largest = 0;
+  for (int k = 0; k < n; ++k) {
+    Real norm2 = 0;
+    for (int i = k; i < m; ++i)
+      norm2 += std::norm(qr_.template row<S21UncheckedAccess>(i)[k]);
+    T &x0 = qr_.template row<S21UncheckedAccess>(k)[k];
+    if (norm2 == Real(0)) continue;
+    const Real sigma = std::sqrt(norm2);
+    const Real magnitude = std::abs(x0);
+    const T alpha =
+        magnitude == Real(0) ? T(-sigma) : -x0 / magnitude * sigma;
+    const T v0 = x0 - alpha;
+    Real vnorm2 = 1;
+    for (int i = k + 1; i < m; ++i) {
+      T &vi = qr_.template row<S21UncheckedAccess>(i)[k];
+      vi /= v0;
+      vnorm2 += std::norm(vi);
+    }
+    tau_[k] = T(2 / vnorm2);
+    x0 = alpha;
+    largest = std::max(largest, sigma);
+    ApplyReflector(k, qr_.data(), qr_.get_stride(), k + 1, n);
+  }
+  const Real tolerance =
+      largest * std::max(m, n) * std::numeric_limits<Real>::epsilon();
+  for (int k = 0; k < n; ++k)
+    if (!(std::abs(qr_.template row<S21UncheckedAccess>(k)[k]) > tolerance))
+      rank_deficient_ = true;
+}
+
+// x -= tau * v * (v^H * x), walking whole row slices of x so both passes
+// stay contiguous. x has row stride ldx and as many rows as qr_.
+template <typename T>
+void S21BasicQRDecomposition<T>::ApplyReflector(int k, T *x, size_t ldx,
+                                                int j0, int j1) const {
+  if (tau_[k] == T(0) || j0 >= j1) return;
+  const int m = qr_.get_rows();
+  T *xk = x + k * ldx;
+  std::vector<T> w(xk + j0, xk + j1);
+  for (int i = k + 1; i < m; ++i) {
+    const T vi = Conj(qr_.template row<S21UncheckedAccess>(i)[k]);
+    const T *xi = x + i * ldx;
+    for (int j = j0; j < j1; ++j) w[j - j0] += vi * xi[j];
+  }
+  for (T &wj : w) wj *= tau_[k];
+  for (int j = j0; j < j1; ++j) xk[j] -= w[j - j0];
+  for (int i = k + 1; i < m; ++i) {
+    const T vi = qr_.template row<S21UncheckedAccess>(i)[k];
+    T *xi = x + i * ldx;
+    for (int j = j0; j < j1; ++j) xi[j] -= vi * w[j - j0];
+  }
+}
+
+template <typename T>
+int S21BasicQRDecomposition<T>::get_rows() const {
+  return qr_.get_rows();
+}
+
+template <typename T>
+int S21BasicQRDecomposition<T>::get_cols() const {
+  return qr_.get_cols();
+}
+
+template <typename T>
+const S21BasicMatrix<T> &S21BasicQRDecomposition<T>::get_qr() const {
+  return qr_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQRDecomposition<T>::R() const {
+  const int n = qr_.get_cols();
+  S21BasicMatrix<T> r(n, n);
+  for (int i = 0; i < n; ++i) {
+    const T *src = qr_.template row<S21UncheckedAccess>(i);
+    std::copy(src + i, src + n, r.template row<S21UncheckedAccess>(i) + i);
+  }
+  return r;
+}
+
+template <typename T>
+bool S21BasicQRDecomposition<T>::IsRankDeficient() const {
+  return rank_deficient_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQRDecomposition<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  if (b.get_rows() != qr_.get_rows())
+    throw MatrixException(
+        "Solve: Right-hand side rows do not match the matrix rows.");
+  if (rank_deficient_)
+    throw MatrixException("Solve: Matrix is rank deficient.");
+  const int n = qr_.get_cols();
+  const int m = b.get_cols();
+  S21BasicMatrix<T> y(b);
+  S21BasicMatrix<T> x(n, m);
+  T *y0 = y.data(), *x0 = x.data();
+  const size_t ldy = y.get_stride(), ldx = x.get_stride();
+  S21ThreadPool::ForRange(
+      m, static_cast<size_t>(qr_.get_rows()) * n * m,
+      [&](int64_t j0, int64_t j1) {
+        // y = Q^H * b.
+        for (int k = 0; k < n; ++k) ApplyReflector(k, y0, ldy, j0, j1);
+        // R * x = y(0:n), backward.
+        for (int i = n - 1; i >= 0; --i) {
+          const T *r = qr_.template row<S21UncheckedAccess>(i);
+          T *xi = x0 + i * ldx;
+          const T *yi = y0 + i * ldy;
+          for (int64_t j = j0; j < j1; ++j) xi[j] = yi[j];
+          for (int k = i + 1; k < n; ++k) {
+            const T *xk = x0 + k * ldx;
+            for (int64_t j = j0; j < j1; ++j) xi[j] -= r[k] * xk[j];
+          }
+          for (int64_t j = j0; j < j1; ++j) xi[j] /= r[i];
+        }
+      });
+  return x;
+}
+
+template <typename T>
+S21BasicLinearSolver<T>::S21BasicLinearSolver(const S21BasicMatrix<T> &matrix,
+                                              S21SolveHint hint) {
+  if (hint == S21SolveHint::kPositiveDefinite ||
+      (hint == S21SolveHint::kAuto && LooksPositiveDefinite(matrix))) {
+    cholesky_.emplace(matrix);
+    if (!cholesky_->IsPositiveDefinite()) {
+      if (hint == S21SolveHint::kPositiveDefinite)
+        throw MatrixException(
+            "LinearSolver: Matrix is not positive definite.");
+      cholesky_.reset();
+    }
+  }
+  if (!cholesky_) lu_.emplace(matrix);
+}
+
+template <typename T>
+S21SolveMethod S21BasicLinearSolver<T>::get_method() const {
+  return cholesky_ ? S21SolveMethod::kCholesky : S21SolveMethod::kLu;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLinearSolver<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  return cholesky_ ? cholesky_->Solve(b) : lu_->Solve(b);
+}
+
+// The diagonal goes first, being cheap and enough to reject most general
+// matrices; the symmetry check walks square tiles so the transposed reads
+// stay in cache.
+template <typename T>
+bool S21BasicLinearSolver<T>::LooksPositiveDefinite(
+    const S21BasicMatrix<T> &matrix) {
+  using Real = typename S21MatrixTraits<T>::Real;
+  const Real tolerance = kSymmetryUlps * std::numeric_limits<Real>::epsilon();
+  const int n = matrix.get_rows();
+  if (n != matrix.get_cols() || matrix.empty()) return false;
+  const size_t lda = matrix.get_stride();
+  const T *a = matrix.data();
+  for (int i = 0; i < n; ++i)
+    if (!(std::real(a[i * lda + i]) > Real(0)) ||
+        std::imag(a[i * lda + i]) != Real(0))
+      return false;
+  for (int ib = 0; ib < n; ib += kSymmetryTile) {
+    for (int jb = 0; jb <= ib; jb += kSymmetryTile) {
+      const int iend = std::min(ib + kSymmetryTile, n);
+      for (int i = ib; i < iend; ++i) {
+        const int jend = std::min(jb + kSymmetryTile, i);
+        for (int j = jb; j < jend; ++j) {
+          const T x = a[i * lda + j], y = Conj(a[j * lda + i]);
+          if (std::norm(x - y) >
+              tolerance * tolerance * std::max(std::norm(x), std::norm(y)))
+            return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template class S21BasicCholeskyDecomposition<float>;
+template class S21BasicCholeskyDecomposition<double>;
+template class S21BasicCholeskyDecomposition<long double>;
+template class S21BasicCholeskyDecomposition<std::complex<double>>;
+template class S21BasicQRDecomposition<float>;
+template class S21BasicQRDecomposition<double>;
+template class S21BasicQRDecomposition<long double>;
+template class S21BasicQRDecomposition<std::complex<double>>;
+template class S21BasicLinearSolver<float>;
+template class S21BasicLinearSolver<double>;
+template class S21BasicLinearSolver<long double>;
+template class S21BasicLinearSolver<std::complex<double>>;
@@ -0,0 +1,102 @@
+#ifndef S21_MATRIX_SOLVE
+#define S21_MATRIX_SOLVE
+
+#include <optional>
+#include <vector>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization of a Hermitian (symmetric, for real elements)
+// positive definite matrix, A = L * L^H, with L lower triangular. Only the
+// lower triangle of A is read. About half the work of LU and no pivoting.
+template <typename T>
+class S21BasicCholeskyDecomposition {
+ private:
+  S21BasicMatrix<T> l_;
+  bool positive_definite_;
+
+  void Factorize();
+
+ public:
+  explicit S21BasicCholeskyDecomposition(const S21BasicMatrix<T> &matrix);
+
+  int get_size() const;
+  const S21BasicMatrix<T> &get_l() const;
+
+  // False when a pivot came out non-positive: A is not positive definite
+  // and get_l() is incomplete.
+  bool IsPositiveDefinite() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+};
+
+// Householder QR of an m x n matrix with m >= n, A = Q * R. R is kept in
+// the upper triangle, the Householder vectors below it (leading 1 not
+// stored) with their scales in tau. Solve() returns the least squares
+// solution of A * x = b without forming Q.
+template <typename T>
+class S21BasicQRDecomposition {
+ private:
+  S21BasicMatrix<T> qr_;
+  std::vector<T> tau_;
+  bool rank_deficient_;
+
+  void Factorize();
+  // Applies H(k) ... H(0) = Q^H, restricted to columns [j0, j1) of x.
+  void ApplyReflector(int k, T *x, size_t ldx, int j0, int j1) const;
+
+ public:
+  explicit S21BasicQRDecomposition(const S21BasicMatrix<T> &matrix);
+
+  int get_rows() const;
+  int get_cols() const;
+  const S21BasicMatrix<T> &get_qr() const;
+  S21BasicMatrix<T> R() const;
+
+  // True when a diagonal element of R is negligible against the largest.
+  bool IsRankDeficient() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+};
+
+enum class S21SolveMethod { kLu, kCholesky };
+
+// Factors a square matrix once and solves it against any number of
+// right-hand sides. S21SolveHint::kAuto takes Cholesky when the matrix is
+// Hermitian with a positive diagonal and the factorization succeeds, LU
+// otherwise.
+template <typename T>
+class S21BasicLinearSolver {
+ private:
+  std::optional<S21BasicCholeskyDecomposition<T>> cholesky_;
+  std::optional<S21BasicLUDecomposition<T>> lu_;
+
+ public:
+  explicit S21BasicLinearSolver(const S21BasicMatrix<T> &matrix,
+                                S21SolveHint hint = S21SolveHint::kAuto);
+
+  S21SolveMethod get_method() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+
+  // Hermitian up to rounding, with a positive real diagonal: the cheap
+  // necessary conditions for positive definiteness.
+  static bool LooksPositiveDefinite(const S21BasicMatrix<T> &matrix);
+};
+
+using S21CholeskyDecomposition = S21BasicCholeskyDecomposition<double>;
+using S21QRDecomposition = S21BasicQRDecomposition<double>;
+using S21LinearSolver = S21BasicLinearSolver<double>;
+
+extern template class S21BasicCholeskyDecomposition<float>;
+extern template class S21BasicCholeskyDecomposition<double>;
+extern template class S21BasicCholeskyDecomposition<long double>;
+extern template class S21BasicCholeskyDecomposition<std::complex<double>>;
+extern template class S21BasicQRDecomposition<float>;
+extern template class S21BasicQRDecomposition<double>;
+extern template class S21BasicQRDecomposition<long double>;
+extern template class S21BasicQRDecomposition<std::complex<double>>;
+extern template class S21BasicLinearSolver<float>;
+extern template class S21BasicLinearSolver<double>;
+extern template class S21BasicLinearSolver<long double>;
+extern template class S21BasicLinearSolver<std::complex<double>>;
+
+#endif  // S21_MATRIX_SOLVE
@@ -0,0 +1,324 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : rows_(0), cols_(0), format_(S21SparseFormat::kCsr), ptr_(1, 0) {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows <= 0 || cols <= 0)
+    throw MatrixException("SparseMatrix: Matrix cols/rows out of range");
+  ptr_.assign(Outer() + 1, 0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T> &dense,
+                                              S21SparseFormat format)
+    : S21BasicSparseMatrix(dense.get_rows(), dense.get_cols()) {
+  for (int i = 0; i < rows_; ++i) {
+    const T *row = dense.row(i);
+    for (int j = 0; j < cols_; ++j) {
+      if (row[j] == T(0)) continue;
+      index_.push_back(j);
+      values_.push_back(row[j]);
+    }
+    ptr_[i + 1] = index_.size();
+  }
+  if (format != format_) *this = ToFormat(format);
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::Outer() const {
+  return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::Inner() const {
+  return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::get_rows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::get_cols() const {
+  return cols_;
+}
+
+template <typename T>
+S21SparseFormat S21BasicSparseMatrix<T>::get_format() const {
+  return format_;
+}
+
+template <typename T>
+size_t S21BasicSparseMatrix<T>::NonZeros() const {
+  return values_.size();
+}
+
+template <typename T>
+const std::vector<size_t> &S21BasicSparseMatrix<T>::get_ptr() const {
+  return ptr_;
+}
+
+template <typename T>
+const std::vector<int> &S21BasicSparseMatrix<T>::get_index() const {
+  return index_;
+}
+
+template <typename T>
+const std::vector<T> &S21BasicSparseMatrix<T>::get_values() const {
+  return values_;
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("Operator(): Index out of bounds.");
+  int outer = format_ == S21SparseFormat::kCsr ? row : col;
+  int inner = format_ == S21SparseFormat::kCsr ? col : row;
+  auto begin = index_.begin() + ptr_[outer];
+  auto end = index_.begin() + ptr_[outer + 1];
+  auto it = std::lower_bound(begin, end, inner);
+  return it != end && *it == inner ? values_[it - index_.begin()] : T(0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Reinterpreted() const {
+  S21BasicSparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ = format_ == S21SparseFormat::kCsr ? S21SparseFormat::kCsc
+                                                    : S21SparseFormat::kCsr;
+  return result;
+}
+
+// Counting sort of the entries by inner index: walking the outer slices in
+// order leaves every new slice sorted.
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) return *this;
+  S21BasicSparseMatrix result;
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  result.format_ = format;
+  result.ptr_.assign(Inner() + 1, 0);
+  result.index_.resize(index_.size());
+  result.values_.resize(values_.size());
+  for (int inner : index_) ++result.ptr_[inner + 1];
+  for (int k = 0; k < Inner(); ++k) result.ptr_[k + 1] += result.ptr_[k];
+  std::vector<size_t> next(result.ptr_.begin(), result.ptr_.end() - 1);
+  for (int outer = 0; outer < Outer(); ++outer) {
+    for (size_t p = ptr_[outer]; p < ptr_[outer + 1]; ++p) {
+      size_t q = next[index_[p]]++;
+      result.index_[q] = outer;
+      result.values_[q] = values_[p];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(rows_, cols_);
+  for (int outer = 0; outer < Outer(); ++outer) {
+    for (size_t p = ptr_[outer]; p < ptr_[outer + 1]; ++p) {
+      if (format_ == S21SparseFormat::kCsr)
+        result.row(outer)[index_[p]] = values_[p];
+      else
+        result.row(index_[p])[outer] = values_[p];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  return Reinterpreted().ToFormat(format_);
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::MulVector(
+    const std::vector<T> &x) const {
+  if (x.size() != static_cast<size_t>(cols_))
+    throw MatrixException(
+        "MulVector: Vector length does not match the matrix columns.");
+  std::vector<T> y(rows_, T(0));
+  if (format_ == S21SparseFormat::kCsr) {
+    // Rows are independent dot products.
+    S21ThreadPool::ForRange(rows_, values_.size(),
+                            [&](int64_t begin, int64_t end) {
+                              for (int64_t i = begin; i < end; ++i) {
+                                T sum = T(0);
+                                for (size_t p = ptr_[i]; p < ptr_[i + 1]; ++p)
+                                  sum += values_[p] * x[index_[p]];
+                                y[i] = sum;
+                              }
+                            });
+  } else {
+    // Columns scatter into shared rows of y, so this stays serial.
+    for (int j = 0; j < cols_; ++j)
+      for (size_t p = ptr_[j]; p < ptr_[j + 1]; ++p)
+        y[index_[p]] += values_[p] * x[j];
+  }
+  return y;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulMatrix(
+    const S21BasicMatrix<T> &other) const {
+  if (other.empty() || cols_ != other.get_rows())
+    throw MatrixException(
+        "MulMatrix: Matrices dimensions do not match for multiplication.");
+  const int n = other.get_cols();
+  S21BasicMatrix<T> result(rows_, n);
+  const auto &simd = s21::Simd<T>();
+  if (format_ == S21SparseFormat::kCsr) {
+    T *out = result.data();
+    const size_t ldr = result.get_stride();
+    S21ThreadPool::ForRange(
+        rows_, values_.size() * n, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            T *dst = out + i * ldr;
+            for (size_t p = ptr_[i]; p < ptr_[i + 1]; ++p)
+              simd.axpy(dst, values_[p],
+                        other.template row<S21UncheckedAccess>(index_[p]),
+                        n);
+          }
+        });
+  } else {
+    for (int k = 0; k < cols_; ++k) {
+      const T *src = other.row(k);
+      for (size_t p = ptr_[k]; p < ptr_[k + 1]; ++p)
+        simd.axpy(result.row(index_[p]), values_[p], src, n);
+    }
+  }
+  return result;
+}
+
+// Merges the sorted inner indices of matching outer slices.
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::SumMatrix(
+    const S21BasicSparseMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw MatrixException(S21AddOp::kMismatch);
+  if (other.format_ != format_) return SumMatrix(other.ToFormat(format_));
+  S21BasicSparseMatrix result;
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  result.format_ = format_;
+  result.ptr_.assign(Outer() + 1, 0);
+  result.index_.reserve(values_.size() + other.values_.size());
+  result.values_.reserve(values_.size() + other.values_.size());
+  for (int outer = 0; outer < Outer(); ++outer) {
+    size_t p = ptr_[outer], p_end = ptr_[outer + 1];
+    size_t q = other.ptr_[outer], q_end = other.ptr_[outer + 1];
+    while (p < p_end || q < q_end) {
+      if (q == q_end || (p < p_end && index_[p] < other.index_[q])) {
+        result.index_.push_back(index_[p]);
+        result.values_.push_back(values_[p++]);
+      } else if (p == p_end || other.index_[q] < index_[p]) {
+        result.index_.push_back(other.index_[q]);
+        result.values_.push_back(other.values_[q++]);
+      } else {
+        result.index_.push_back(index_[p]);
+        result.values_.push_back(values_[p++] + other.values_[q++]);
+      }
+    }
+    result.ptr_[outer + 1] = result.index_.size();
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix &other) const {
+  return SumMatrix(other);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T> &other) const {
+  return MulMatrix(other);
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::operator*(
+    const std::vector<T> &x) const {
+  return MulVector(x);
+}
+
+template <typename T>
+S21BasicSparseBuilder<T>::S21BasicSparseBuilder(int rows, int cols)
+    : rows_(rows), cols_(cols) {
+  if (rows <= 0 || cols <= 0)
+    throw MatrixException("SparseBuilder: Matrix cols/rows out of range");
+}
+
+template <typename T>
+void S21BasicSparseBuilder<T>::Reserve(size_t count) {
+  triplets_.reserve(count);
+}
+
+template <typename T>
+void S21BasicSparseBuilder<T>::Add(int row, int col, T value) {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("Add: Index out of bounds.");
+  triplets_.push_back({row, col, value});
+}
+
+template <typename T>
+size_t S21BasicSparseBuilder<T>::size() const {
+  return triplets_.size();
+}
+
+// Sorts the triplets by (outer, inner) and folds runs of equal positions.
+// The sort is stable, so duplicates are summed in insertion order.
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseBuilder<T>::Build(
+    S21SparseFormat format) const {
+  const bool csr = format == S21SparseFormat::kCsr;
+  std::vector<Triplet> sorted(triplets_);
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [csr](const Triplet &a, const Triplet &b) {
+                     return csr ? (a.row != b.row ? a.row < b.row
+                                                  : a.col < b.col)
+                                : (a.col != b.col ? a.col < b.col
+                                                  : a.row < b.row);
+                   });
+  S21BasicSparseMatrix<T> result(rows_, cols_, format);
+  result.index_.reserve(sorted.size());
+  result.values_.reserve(sorted.size());
+  for (size_t k = 0; k < sorted.size(); ++k) {
+    const Triplet &t = sorted[k];
+    int outer = csr ? t.row : t.col, inner = csr ? t.col : t.row;
+    if (k > 0 && t.row == sorted[k - 1].row && t.col == sorted[k - 1].col) {
+      result.values_.back() += t.value;
+    } else {
+      result.index_.push_back(inner);
+      result.values_.push_back(t.value);
+      ++result.ptr_[outer + 1];
+    }
+  }
+  for (int k = 0; k < result.Outer(); ++k)
+    result.ptr_[k + 1] += result.ptr_[k];
+  return result;
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
+template class S21BasicSparseMatrix<std::complex<double>>;
+template class S21BasicSparseBuilder<float>;
+template class S21BasicSparseBuilder<double>;
+template class S21BasicSparseBuilder<long double>;
+template class S21BasicSparseBuilder<std::complex<double>>;
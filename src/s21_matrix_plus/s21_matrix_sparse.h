@@ -0,0 +1,116 @@
+#ifndef S21_MATRIX_SPARSE
+#define S21_MATRIX_SPARSE
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Compressed sparse row (CSR) or column (CSC) storage.
+enum class S21SparseFormat { kCsr, kCsc };
+
+template <typename T>
+class S21BasicSparseBuilder;
+
+// Sparse matrix that stores only its nonzero elements. In CSR the outer
+// dimension is the rows and the inner one the columns, in CSC the other
+// way round: the entries of outer slice k are [ptr[k], ptr[k + 1]) of
+// index and values, with ascending inner indices and no duplicates.
+// Products against dense matrices and vectors only touch the stored
+// entries, so they cost O(nonzeros) instead of O(rows * cols).
+// Instantiated for the same element types as S21BasicMatrix.
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  using value_type = T;
+
+ private:
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<size_t> ptr_;
+  std::vector<int> index_;
+  std::vector<T> values_;
+
+  int Outer() const;
+  int Inner() const;
+  // The same arrays read in the other format describe the transpose.
+  S21BasicSparseMatrix Reinterpreted() const;
+
+  friend class S21BasicSparseBuilder<T>;
+
+ public:
+  S21BasicSparseMatrix();
+  // A rows x cols matrix of zeros.
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+  // Stores the elements of `dense` that are not zero.
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T> &dense,
+                                S21SparseFormat format = S21SparseFormat::kCsr);
+
+  int get_rows() const;
+  int get_cols() const;
+  S21SparseFormat get_format() const;
+  size_t NonZeros() const;
+  const std::vector<size_t> &get_ptr() const;
+  const std::vector<int> &get_index() const;
+  const std::vector<T> &get_values() const;
+
+  // Element (row, col), zero when it is not stored; a binary search within
+  // the outer slice.
+  T operator()(int row, int col) const;
+
+  // Same matrix in the given format, O(nonzeros + rows + cols).
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+  S21BasicMatrix<T> ToDense() const;
+  // Keeps the format of *this.
+  S21BasicSparseMatrix Transpose() const;
+
+  // y = A * x.
+  std::vector<T> MulVector(const std::vector<T> &x) const;
+  // A * B for a dense B: every stored a(i, k) adds a(i, k) * row k of B to
+  // row i of the result.
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrix<T> &other) const;
+  // Result in the format of *this; the other operand is converted first
+  // when its format differs.
+  S21BasicSparseMatrix SumMatrix(const S21BasicSparseMatrix &other) const;
+
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix &other) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &other) const;
+  std::vector<T> operator*(const std::vector<T> &x) const;
+};
+
+// Collects (row, col, value) triplets in any order and compresses them
+// into a sparse matrix. Values given for the same position are summed.
+template <typename T>
+class S21BasicSparseBuilder {
+ private:
+  struct Triplet {
+    int row, col;
+    T value;
+  };
+  int rows_, cols_;
+  std::vector<Triplet> triplets_;
+
+ public:
+  S21BasicSparseBuilder(int rows, int cols);
+
+  void Reserve(size_t count);
+  void Add(int row, int col, T value);
+  size_t size() const;
+  S21BasicSparseMatrix<T> Build(
+      S21SparseFormat format = S21SparseFormat::kCsr) const;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21SparseBuilder = S21BasicSparseBuilder<double>;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+extern template class S21BasicSparseMatrix<std::complex<double>>;
+extern template class S21BasicSparseBuilder<float>;
+extern template class S21BasicSparseBuilder<double>;
+extern template class S21BasicSparseBuilder<long double>;
+extern template class S21BasicSparseBuilder<std::complex<double>>;
+
+#endif  // S21_MATRIX_SPARSE
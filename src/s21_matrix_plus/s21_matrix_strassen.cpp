@@ -0,0 +1,252 @@
+#include "s21_matrix_strassen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_gemm.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<int> crossover{kStrassenCrossover};
+
+// z = op(x, y) over a rows x cols block. z may be x or y.
+template <typename T, typename Op>
+void Elementwise(int rows, int cols, T *z, size_t ldz, const T *x, size_t ldx,
+                 const T *y, size_t ldy, Op op) {
+  S21ThreadPool::ForRange(
+      rows, static_cast<size_t>(rows) * cols, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          T *zi = z + i * ldz;
+          const T *xi = x + i * ldx, *yi = y + i * ldy;
+          for (int j = 0; j < cols; ++j) zi[j] = op(xi[j], yi[j]);
+        }
+      });
+}
+
+// One quadrant split of the operands: the even leading part of each
+// dimension is halved, odd trailing rows and columns are left to Peel().
+template <typename T>
+struct Quadrants {
+  int m2, n2, k2;
+  const T *a11, *a12, *a21, *a22;
+  const T *b11, *b12, *b21, *b22;
+  T *c11, *c12, *c21, *c22;
+  size_t lda, ldb, ldc;
+
+  Quadrants(int m, int n, int k, const T *a, size_t lda_, const T *b,
+            size_t ldb_, T *c, size_t ldc_)
+      : m2(m / 2), n2(n / 2), k2(k / 2), lda(lda_), ldb(ldb_), ldc(ldc_) {
+    a11 = a;
+    a12 = a + k2;
+    a21 = a + m2 * lda;
+    a22 = a21 + k2;
+    b11 = b;
+    b12 = b + n2;
+    b21 = b + k2 * ldb;
+    b22 = b21 + n2;
+    c11 = c;
+    c12 = c + n2;
+    c21 = c + m2 * ldc;
+    c22 = c21 + n2;
+  }
+
+  // z = x + y and z = x - y on half-size blocks of the given shape.
+  void Add(int rows, int cols, T *z, size_t ldz, const T *x, size_t ldx,
+           const T *y, size_t ldy) const {
+    Elementwise(rows, cols, z, ldz, x, ldx, y, ldy,
+                [](T p, T q) { return p + q; });
+  }
+  void Sub(int rows, int cols, T *z, size_t ldz, const T *x, size_t ldx,
+           const T *y, size_t ldy) const {
+    Elementwise(rows, cols, z, ldz, x, ldx, y, ldy,
+                [](T p, T q) { return p - q; });
+  }
+};
+
+bool IsLeaf(int m, int n, int k, int cutoff) {
+  return m <= cutoff || n <= cutoff || k <= cutoff;
+}
+
+// Workspace of the sequential recursion below an m x k by k x n product.
+size_t SequentialWorkspace(int m, int n, int k, int cutoff) {
+  if (IsLeaf(m, n, k, cutoff)) return 0;
+  const size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  return m2 * std::max(k2, n2) + k2 * n2 +
+         SequentialWorkspace(m2, n2, k2, cutoff);
+}
+
+size_t ParallelWorkspace(int m, int n, int k, int cutoff) {
+  const size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  return 4 * m2 * k2 + 4 * k2 * n2 + 3 * m2 * n2 +
+         7 * SequentialWorkspace(m2, n2, k2, cutoff);
+}
+
+// Products with the odd last row, column or inner index that the even
+// quadrant recursion left out.
+template <typename T>
+void Peel(int m, int n, int k, const T *a, size_t lda, const T *b,
+          size_t ldb, T *c, size_t ldc) {
+  const int me = m / 2 * 2, ne = n / 2 * 2;
+  if (k % 2)
+    Gemm(me, ne, 1, T(1), a + k - 1, lda, b + (k - 1) * ldb, ldb, c, ldc,
+         true);
+  if (n % 2) Gemm(m, 1, k, T(1), a, lda, b + n - 1, ldb, c + n - 1, ldc);
+  if (m % 2)
+    Gemm(1, ne, k, T(1), a + (m - 1) * lda, lda, b, ldb, c + (m - 1) * ldc,
+         ldc);
+}
+
+// The memory-efficient schedule of Boyer, Dumas, Pernet and Zhou for
+// C = A * B: the S and T operands and P1 go through two temporaries X and
+// Y, every other product lands in the quadrant of C it ends up in.
+template <typename T>
+void Winograd(int m, int n, int k, const T *a, size_t lda, const T *b,
+              size_t ldb, T *c, size_t ldc, T *work, int cutoff) {
+  if (IsLeaf(m, n, k, cutoff)) {
+    Gemm(m, n, k, T(1), a, lda, b, ldb, c, ldc);
+    return;
+  }
+  const Quadrants<T> q(m, n, k, a, lda, b, ldb, c, ldc);
+  const int m2 = q.m2, n2 = q.n2, k2 = q.k2;
+  const size_t ldx = std::max(k2, n2), ldy = n2;
+  T *x = work, *y = x + m2 * ldx, *next = y + static_cast<size_t>(k2) * n2;
+  auto product = [&](const T *l, size_t ldl, const T *r, size_t ldr, T *dst,
+                     size_t ldd) {
+    Winograd(m2, n2, k2, l, ldl, r, ldr, dst, ldd, next, cutoff);
+  };
+
+  q.Sub(m2, k2, x, ldx, q.a11, lda, q.a21, lda);      // S3
+  q.Sub(k2, n2, y, ldy, q.b22, ldb, q.b12, ldb);      // T3
+  product(x, ldx, y, ldy, q.c21, ldc);                // P7
+  q.Add(m2, k2, x, ldx, q.a21, lda, q.a22, lda);      // S1
+  q.Sub(k2, n2, y, ldy, q.b12, ldb, q.b11, ldb);      // T1
+  product(x, ldx, y, ldy, q.c22, ldc);                // P5
+  q.Sub(m2, k2, x, ldx, x, ldx, q.a11, lda);          // S2
+  q.Sub(k2, n2, y, ldy, q.b22, ldb, y, ldy);          // T2
+  product(x, ldx, y, ldy, q.c12, ldc);                // P6
+  q.Sub(m2, k2, x, ldx, q.a12, lda, x, ldx);          // S4
+  product(x, ldx, q.b22, ldb, q.c11, ldc);            // P3
+  product(q.a11, lda, q.b11, ldb, x, ldx);            // P1
+  q.Add(m2, n2, q.c12, ldc, x, ldx, q.c12, ldc);      // U2 = P1 + P6
+  q.Add(m2, n2, q.c21, ldc, q.c12, ldc, q.c21, ldc);  // U3 = U2 + P7
+  q.Add(m2, n2, q.c12, ldc, q.c12, ldc, q.c22, ldc);  // U4 = U2 + P5
+  q.Add(m2, n2, q.c22, ldc, q.c21, ldc, q.c22, ldc);  // U7 = U3 + P5
+  q.Add(m2, n2, q.c12, ldc, q.c12, ldc, q.c11, ldc);  // U5 = U4 + P3
+  q.Sub(k2, n2, y, ldy, y, ldy, q.b21, ldb);          // T4
+  product(q.a22, lda, y, ldy, q.c11, ldc);            // P4
+  q.Sub(m2, n2, q.c21, ldc, q.c21, ldc, q.c11, ldc);  // U6 = U3 - P4
+  product(q.a12, lda, q.b21, ldb, q.c11, ldc);        // P2
+  q.Add(m2, n2, q.c11, ldc, q.c11, ldc, x, ldx);      // U1 = P1 + P2
+  Peel(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+// Top level with the 7 products as parallel tasks. All S and T operands
+// are formed first; P3, P5, P6 and P7 go to their quadrants of C, P1, P2
+// and P4 to buffers, and the U sums follow the sequential schedule.
+template <typename T>
+void ParallelWinograd(int m, int n, int k, const T *a, size_t lda,
+                      const T *b, size_t ldb, T *c, size_t ldc, T *work,
+                      int cutoff) {
+  const Quadrants<T> q(m, n, k, a, lda, b, ldb, c, ldc);
+  const int m2 = q.m2, n2 = q.n2, k2 = q.k2;
+  const size_t sa = static_cast<size_t>(m2) * k2;
+  const size_t sb = static_cast<size_t>(k2) * n2;
+  const size_t sc = static_cast<size_t>(m2) * n2;
+  T *s[4], *t[4], *p[3];
+  for (int i = 0; i < 4; ++i) s[i] = work + i * sa;
+  for (int i = 0; i < 4; ++i) t[i] = work + 4 * sa + i * sb;
+  for (int i = 0; i < 3; ++i) p[i] = work + 4 * sa + 4 * sb + i * sc;
+  T *rest = work + 4 * sa + 4 * sb + 3 * sc;
+  const size_t per_task = SequentialWorkspace(m2, n2, k2, cutoff);
+
+  q.Add(m2, k2, s[0], k2, q.a21, lda, q.a22, lda);  // S1
+  q.Sub(m2, k2, s[1], k2, s[0], k2, q.a11, lda);    // S2
+  q.Sub(m2, k2, s[2], k2, q.a11, lda, q.a21, lda);  // S3
+  q.Sub(m2, k2, s[3], k2, q.a12, lda, s[1], k2);    // S4
+  q.Sub(k2, n2, t[0], n2, q.b12, ldb, q.b11, ldb);  // T1
+  q.Sub(k2, n2, t[1], n2, q.b22, ldb, t[0], n2);    // T2
+  q.Sub(k2, n2, t[2], n2, q.b22, ldb, q.b12, ldb);  // T3
+  q.Sub(k2, n2, t[3], n2, t[1], n2, q.b21, ldb);    // T4
+  struct Task {
+    const T *l;
+    size_t ldl;
+    const T *r;
+    size_t ldr;
+    T *dst;
+    size_t ldd;
+  };
+  const Task tasks[7] = {
+      {q.a11, lda, q.b11, ldb, p[0], size_t(n2)},        // P1
+      {q.a12, lda, q.b21, ldb, p[1], size_t(n2)},        // P2
+      {s[3], size_t(k2), q.b22, ldb, q.c11, ldc},        // P3
+      {q.a22, lda, t[3], size_t(n2), p[2], size_t(n2)},  // P4
+      {s[0], size_t(k2), t[0], size_t(n2), q.c22, ldc},  // P5
+      {s[1], size_t(k2), t[1], size_t(n2), q.c12, ldc},  // P6
+      {s[2], size_t(k2), t[2], size_t(n2), q.c21, ldc},  // P7
+  };
+  S21ThreadPool::Current().ParallelFor(
+      7, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i)
+          Winograd(m2, n2, k2, tasks[i].l, tasks[i].ldl, tasks[i].r,
+                   tasks[i].ldr, tasks[i].dst, tasks[i].ldd,
+                   rest + i * per_task, cutoff);
+      });
+  q.Add(m2, n2, q.c12, ldc, p[0], n2, q.c12, ldc);    // U2 = P1 + P6
+  q.Add(m2, n2, q.c21, ldc, q.c12, ldc, q.c21, ldc);  // U3 = U2 + P7
+  q.Add(m2, n2, q.c12, ldc, q.c12, ldc, q.c22, ldc);  // U4 = U2 + P5
+  q.Add(m2, n2, q.c22, ldc, q.c21, ldc, q.c22, ldc);  // U7 = U3 + P5
+  q.Add(m2, n2, q.c12, ldc, q.c12, ldc, q.c11, ldc);  // U5 = U4 + P3
+  q.Sub(m2, n2, q.c21, ldc, q.c21, ldc, p[2], n2);    // U6 = U3 - P4
+  q.Add(m2, n2, q.c11, ldc, p[0], n2, p[1], n2);      // U1 = P1 + P2
+  Peel(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+}  // namespace
+
+int GetStrassenCrossover() { return crossover.load(std::memory_order_relaxed); }
+
+void SetStrassenCrossover(int size) {
+  crossover.store(std::max(size, 1), std::memory_order_relaxed);
+}
+
+bool PreferStrassen(int m, int n, int k) {
+  return std::min({m, n, k}) >= 4 * GetStrassenCrossover();
+}
+
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T *a, size_t lda, const T *b,
+                  size_t ldb, T *c, size_t ldc) {
+  const int cutoff = GetStrassenCrossover();
+  if (IsLeaf(m, n, k, cutoff)) {
+    Gemm(m, n, k, T(1), a, lda, b, ldb, c, ldc);
+    return;
+  }
+  const bool parallel = S21ThreadPool::Current().IsParallel(
+      static_cast<size_t>(m) * n);
+  std::vector<T, S21AlignedAllocator<T>> work(
+      parallel ? ParallelWorkspace(m, n, k, cutoff)
+               : SequentialWorkspace(m, n, k, cutoff),
+      S21AlignedAllocator<T>::Heap());
+  if (parallel)
+    ParallelWinograd(m, n, k, a, lda, b, ldb, c, ldc, work.data(), cutoff);
+  else
+    Winograd(m, n, k, a, lda, b, ldb, c, ldc, work.data(), cutoff);
+}
+
+template void StrassenGemm<float>(int, int, int, const float *, size_t,
+                                  const float *, size_t, float *, size_t);
+template void StrassenGemm<double>(int, int, int, const double *, size_t,
+                                   const double *, size_t, double *, size_t);
+template void StrassenGemm<long double>(int, int, int, const long double *,
+                                        size_t, const long double *, size_t,
+                                        long double *, size_t);
+template void StrassenGemm<std::complex<double>>(
+    int, int, int, const std::complex<double> *, size_t,
+    const std::complex<double> *, size_t, std::complex<double> *, size_t);
+
+}  // namespace s21
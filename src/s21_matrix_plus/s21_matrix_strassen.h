@@ -0,0 +1,53 @@
+#ifndef S21_MATRIX_STRASSEN
+#define S21_MATRIX_STRASSEN
+
+#include <complex>
+#include <cstddef>
+
+namespace s21 {
+
+// Default size below which StrassenGemm hands blocks to the classical
+// Gemm: once a block is this small, the packed kernel beats saving one
+// product in eight.
+constexpr int kStrassenCrossover = 256;
+
+// Crossover used by StrassenGemm and by PreferStrassen, process-wide.
+int GetStrassenCrossover();
+void SetStrassenCrossover(int size);
+
+// The S21MulAlgorithm::kAuto heuristic: true when every dimension is at
+// least four times the crossover. One level saves too little to be worth
+// its extra rounding error; from two levels on the product is clearly
+// faster (about 1.6x at 2048 on one core).
+bool PreferStrassen(int m, int n, int k);
+
+// C = A * B by the Strassen-Winograd recursion: 7 half-size products and
+// 15 additions per level instead of 8 products, O(n^2.81) overall. Blocks
+// with a dimension at or below the crossover go to Gemm, odd dimensions
+// are peeled off and fixed up with Gemm. Row-major, leading dimensions as
+// in Gemm; C must not overlap A or B.
+//
+// The workspace for every level is allocated once per call, about
+// (m * max(k, n) + k * n) / 3 elements. When the current thread pool runs
+// in parallel, the 7 products of the top level are independent tasks,
+// each with its own workspace, and the operands and products they need
+// take another m * k + k * n + 3 / 4 * m * n elements.
+//
+// Error bound. With unit roundoff u, recursion stopped at n0 and square
+// n = 2^l * n0 (Higham, Accuracy and Stability of Numerical Algorithms,
+// 2nd ed., sec. 23.2.2), the computed product satisfies
+//   max|C - C*| <= ((n / n0)^log2(18) * (n0^2 + 6 * n0) - 6 * n) * u
+//                  * max|A| * max|B|,
+// normwise only, against the componentwise |C - C*| <= n * u * |A| * |B|
+// of the classical product. Each level multiplies the constant by about
+// 18 / 4, so with the default crossover an 8192 product (4 levels) loses
+// roughly two to three decimal digits more than Gemm in the worst case;
+// typical errors are far smaller. Do not use it where componentwise
+// accuracy matters, e.g. on badly scaled rows or columns.
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T *a, size_t lda, const T *b,
+                  size_t ldb, T *c, size_t ldc);
+
+}  // namespace s21
+
+#endif  // S21_MATRIX_STRASSEN
@@ -0,0 +1,441 @@
+#include "s21_matrix_text.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_exception.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Output is flushed to the stream in blocks of this many bytes.
+constexpr size_t kWriteBlock = size_t(1) << 20;
+
+struct Line {
+  const char *begin, *end;
+  size_t number;
+};
+
+bool IsBlank(char c) { return c == ' ' || c == '\t'; }
+
+MatrixException LineError(const char *func, size_t number,
+                          const std::string &what) {
+  return MatrixException(std::string(func) + ": Line " +
+                         std::to_string(number) + ": " + what);
+}
+
+// Reads `in` about chunk_bytes at a time and calls fn(lines) with the
+// complete lines of each chunk. Trailing '\r' is dropped; blank lines and
+// lines starting with `comment` are skipped but still counted from
+// first_line on.
+template <typename Fn>
+void ForEachChunk(std::istream &in, size_t chunk_bytes, char comment,
+                  size_t first_line, Fn fn) {
+  chunk_bytes = std::max<size_t>(chunk_bytes, 1);
+  std::vector<char> buffer;
+  std::vector<Line> lines;
+  size_t kept = 0, number = first_line;
+  bool eof = false;
+  while (!eof) {
+    buffer.resize(kept + chunk_bytes);
+    in.read(buffer.data() + kept, chunk_bytes);
+    size_t filled = kept + in.gcount();
+    eof = !in;
+    const char *data = buffer.data();
+    // The text up to the last newline is complete; at the end of the
+    // stream everything is.
+    size_t complete = filled;
+    if (!eof) {
+      const char *last = data + filled;
+      while (last != data && last[-1] != '\n') --last;
+      complete = last - data;
+      if (complete == 0) {
+        kept = filled;
+        continue;
+      }
+    }
+    lines.clear();
+    for (const char *p = data, *end = data + complete; p != end;) {
+      const char *eol =
+          static_cast<const char *>(std::memchr(p, '\n', end - p));
+      const char *next = eol ? eol + 1 : end;
+      if (!eol) eol = end;
+      const char *b = p, *e = eol;
+      if (e != b && e[-1] == '\r') --e;
+      while (b != e && IsBlank(*b)) ++b;
+      if (b != e && *b != comment) lines.push_back({b, e, number});
+      ++number;
+      p = next;
+    }
+    if (!lines.empty()) fn(lines);
+    kept = filled - complete;
+    std::memmove(buffer.data(), data + complete, kept);
+  }
+}
+
+// Runs fn(begin, end) over [0, count), on the thread pool when asked to.
+template <typename Fn>
+void ParseRange(size_t count, size_t elements, bool parallel, const Fn &fn) {
+  if (parallel)
+    S21ThreadPool::ForRange(count, elements, fn);
+  else if (count > 0)
+    fn(0, count);
+}
+
+// Parses a number surrounded by optional blanks and advances p past them.
+template <typename T>
+bool ParseNumber(const char *&p, const char *end, T &value) {
+  while (p != end && IsBlank(*p)) ++p;
+  if (p != end && *p == '+' && end - p > 1 && p[1] != '-') ++p;
+  auto [ptr, ec] = std::from_chars(p, end, value);
+  if (ec != std::errc()) return false;
+  p = ptr;
+  while (p != end && IsBlank(*p)) ++p;
+  return true;
+}
+
+// Parses the values of a CSV line into row[0, cols) and returns how many
+// there were, or -1 when one is not a number.
+template <typename T>
+int ParseCsvLine(const Line &line, char delimiter, T *row, int cols) {
+  const char *p = line.begin;
+  int count = 0;
+  for (;;) {
+    T value;
+    if (!ParseNumber(p, line.end, value)) return -1;
+    if (count < cols) row[count] = value;
+    ++count;
+    if (p == line.end) break;
+    if (*p == delimiter)
+      ++p;
+    else if (!IsBlank(delimiter) || !IsBlank(p[-1]))
+      return -1;
+  }
+  return count;
+}
+
+template <typename T>
+void AppendNumber(std::string &out, T value) {
+  char text[64];
+  auto [end, ec] = std::to_chars(text, text + sizeof(text), value);
+  out.append(text, ec == std::errc() ? end : text);
+}
+
+void Flush(std::ostream &out, std::string &block, bool force) {
+  if (!force && block.size() < kWriteBlock) return;
+  out.write(block.data(), block.size());
+  block.clear();
+}
+
+struct MarketHeader {
+  bool coordinate, pattern, symmetric, skew;
+  int rows, cols;
+  size_t entries;
+  size_t next_line;
+};
+
+MarketHeader ReadMarketHeader(std::istream &in) {
+  const char *kFunc = "ReadMatrixMarket";
+  std::string line;
+  if (!std::getline(in, line))
+    throw MatrixException("ReadMatrixMarket: Empty input.");
+  std::transform(line.begin(), line.end(), line.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  std::istringstream banner(line);
+  std::string tag, object, format, field, symmetry;
+  banner >> tag >> object >> format >> field >> symmetry;
+  if (tag != "%%matrixmarket" || object != "matrix")
+    throw LineError(kFunc, 1, "Not a MatrixMarket matrix header.");
+  MarketHeader header = {};
+  if (format != "coordinate" && format != "array")
+    throw LineError(kFunc, 1, "Unknown format " + format + ".");
+  header.coordinate = format == "coordinate";
+  if (field != "real" && field != "double" && field != "integer" &&
+      !(field == "pattern" && header.coordinate))
+    throw LineError(kFunc, 1, "Unsupported field " + field + ".");
+  header.pattern = field == "pattern";
+  if (symmetry != "general" && symmetry != "symmetric" &&
+      symmetry != "skew-symmetric")
+    throw LineError(kFunc, 1, "Unsupported symmetry " + symmetry + ".");
+  header.symmetric = symmetry != "general";
+  header.skew = symmetry == "skew-symmetric";
+
+  size_t number = 1;
+  do {
+    ++number;
+    if (!std::getline(in, line))
+      throw MatrixException("ReadMatrixMarket: Missing size line.");
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first != std::string::npos && line[first] != '%') break;
+  } while (true);
+  header.next_line = number + 1;
+  const char *p = line.data(), *end = p + line.size();
+  if (end != p && end[-1] == '\r') --end;
+  long long rows = 0, cols = 0, entries = 0;
+  bool ok = ParseNumber(p, end, rows) && ParseNumber(p, end, cols);
+  if (ok && header.coordinate) ok = ParseNumber(p, end, entries);
+  if (!ok || p != end || rows <= 0 || cols <= 0 || entries < 0 ||
+      rows > INT32_MAX || cols > INT32_MAX)
+    throw LineError(kFunc, number, "Invalid size line.");
+  if (header.symmetric && rows != cols)
+    throw LineError(kFunc, number, "Symmetric matrix must be square.");
+  header.rows = rows;
+  header.cols = cols;
+  if (header.coordinate) {
+    header.entries = entries;
+  } else if (header.skew) {
+    header.entries = static_cast<size_t>(rows) * (rows - 1) / 2;
+  } else if (header.symmetric) {
+    header.entries = static_cast<size_t>(rows) * (rows + 1) / 2;
+  } else {
+    header.entries = static_cast<size_t>(rows) * cols;
+  }
+  return header;
+}
+
+struct Entry {
+  int row, col;
+};
+
+template <typename T>
+S21BasicSparseMatrix<T> ReadCoordinate(std::istream &in,
+                                       const MarketHeader &header,
+                                       const S21TextOptions &options) {
+  const char *kFunc = "ReadMatrixMarket";
+  S21BasicSparseBuilder<T> builder(header.rows, header.cols);
+  builder.Reserve(header.symmetric ? 2 * header.entries : header.entries);
+  size_t found = 0;
+  std::vector<Entry> entries;
+  std::vector<T> values;
+  ForEachChunk(
+      in, options.chunk_bytes, '%', header.next_line,
+      [&](std::vector<Line> &lines) {
+        const size_t count = lines.size();
+        if (found + count > header.entries)
+          throw LineError(kFunc, lines[header.entries - found].number,
+                          "More entries than declared.");
+        entries.resize(count);
+        values.resize(count);
+        ParseRange(count, count, options.parallel,
+                   [&](int64_t begin, int64_t end) {
+                     for (int64_t k = begin; k < end; ++k) {
+                       const char *p = lines[k].begin, *e = lines[k].end;
+                       int i = 0, j = 0;
+                       T value = T(1);
+                       bool ok = ParseNumber(p, e, i) && ParseNumber(p, e, j) &&
+                                 (header.pattern || ParseNumber(p, e, value));
+                       if (!ok || p != e)
+                         throw LineError(kFunc, lines[k].number,
+                                         "Invalid entry.");
+                       if (i < 1 || i > header.rows || j < 1 ||
+                           j > header.cols)
+                         throw LineError(kFunc, lines[k].number,
+                                         "Index out of bounds.");
+                       entries[k] = {i - 1, j - 1};
+                       values[k] = value;
+                     }
+                   });
+        for (size_t k = 0; k < count; ++k) {
+          builder.Add(entries[k].row, entries[k].col, values[k]);
+          if (header.symmetric && entries[k].row != entries[k].col)
+            builder.Add(entries[k].col, entries[k].row,
+                        header.skew ? -values[k] : values[k]);
+        }
+        found += count;
+      });
+  if (found != header.entries)
+    throw MatrixException("ReadMatrixMarket: Expected " +
+                          std::to_string(header.entries) + " entries, found " +
+                          std::to_string(found) + ".");
+  return builder.Build();
+}
+
+template <typename T>
+S21BasicMatrix<T> ReadArray(std::istream &in, const MarketHeader &header,
+                            const S21TextOptions &options) {
+  const char *kFunc = "ReadMatrixMarket";
+  // Array values come column by column, of the lower triangle only for
+  // symmetric storage.
+  std::vector<T> values;
+  values.reserve(header.entries);
+  ForEachChunk(
+      in, options.chunk_bytes, '%', header.next_line,
+      [&](std::vector<Line> &lines) {
+        const size_t found = values.size(), count = lines.size();
+        if (found + count > header.entries)
+          throw LineError(kFunc, lines[header.entries - found].number,
+                          "More entries than declared.");
+        values.resize(found + count);
+        ParseRange(count, count, options.parallel,
+                   [&](int64_t begin, int64_t end) {
+                     for (int64_t k = begin; k < end; ++k) {
+                       const char *p = lines[k].begin;
+                       if (!ParseNumber(p, lines[k].end, values[found + k]) ||
+                           p != lines[k].end)
+                         throw LineError(kFunc, lines[k].number,
+                                         "Invalid entry.");
+                     }
+                   });
+      });
+  if (values.size() != header.entries)
+    throw MatrixException("ReadMatrixMarket: Expected " +
+                          std::to_string(header.entries) + " entries, found " +
+                          std::to_string(values.size()) + ".");
+  S21BasicMatrix<T> result(header.rows, header.cols);
+  size_t k = 0;
+  for (int j = 0; j < header.cols; ++j) {
+    int first = header.skew ? j + 1 : header.symmetric ? j : 0;
+    for (int i = first; i < header.rows; ++i, ++k) {
+      result(i, j) = values[k];
+      if (header.symmetric) result(j, i) = header.skew ? -values[k] : values[k];
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+template <typename T>
+void S21BasicMatrixText<T>::StreamCsv(std::istream &in, const RowSink &sink,
+                                      const S21TextOptions &options) {
+  int cols = -1;
+  bool skip_header = options.header;
+  std::vector<T> block;
+  ForEachChunk(in, options.chunk_bytes, '\0', 1, [&](std::vector<Line> &lines) {
+    size_t first = 0;
+    if (skip_header) {
+      skip_header = false;
+      first = 1;
+    }
+    if (cols < 0 && first < lines.size()) {
+      cols = ParseCsvLine<T>(lines[first], options.delimiter, nullptr, 0);
+      if (cols < 0)
+        throw LineError("ReadCsv", lines[first].number, "Invalid number.");
+    }
+    const size_t count = lines.size() - first;
+    if (count == 0) return;
+    block.resize(count * cols);
+    ParseRange(count, count * cols, options.parallel,
+               [&](int64_t begin, int64_t end) {
+                 for (int64_t i = begin; i < end; ++i) {
+                   const Line &line = lines[first + i];
+                   int n = ParseCsvLine(line, options.delimiter,
+                                        block.data() + i * cols, cols);
+                   if (n < 0)
+                     throw LineError("ReadCsv", line.number,
+                                     "Invalid number.");
+                   if (n != cols)
+                     throw LineError("ReadCsv", line.number,
+                                     std::to_string(n) + " values, expected " +
+                                         std::to_string(cols) + ".");
+                 }
+               });
+    sink(S21BasicMatrixView<const T>(block.data(), count, cols, cols));
+  });
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixText<T>::ReadCsv(
+    std::istream &in, const S21TextOptions &options) {
+  std::vector<T> values;
+  int rows = 0, cols = 0;
+  StreamCsv(
+      in,
+      [&](S21BasicMatrixView<const T> block) {
+        cols = block.get_cols();
+        rows += block.get_rows();
+        values.insert(values.end(), block.data(),
+                      block.data() + block.get_rows() * cols);
+      },
+      options);
+  if (rows == 0) throw MatrixException("ReadCsv: No data rows.");
+  S21BasicMatrix<T> result(rows, cols);
+  result = S21BasicMatrixView<const T>(values.data(), rows, cols, cols);
+  return result;
+}
+
+template <typename T>
+void S21BasicMatrixText<T>::WriteCsv(std::ostream &out,
+                                     S21BasicMatrixView<const T> matrix,
+                                     char delimiter) {
+  std::string block;
+  block.reserve(kWriteBlock + 64);
+  for (int i = 0; i < matrix.get_rows(); ++i) {
+    const T *row = matrix.row(i);
+    for (int j = 0; j < matrix.get_cols(); ++j) {
+      if (j) block += delimiter;
+      AppendNumber(block, row[j]);
+    }
+    block += '\n';
+    Flush(out, block, false);
+  }
+  Flush(out, block, true);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixText<T>::ReadMatrixMarket(
+    std::istream &in, const S21TextOptions &options) {
+  MarketHeader header = ReadMarketHeader(in);
+  if (header.coordinate)
+    return ReadCoordinate<T>(in, header, options).ToDense();
+  return ReadArray<T>(in, header, options);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicMatrixText<T>::ReadMatrixMarketSparse(
+    std::istream &in, const S21TextOptions &options) {
+  MarketHeader header = ReadMarketHeader(in);
+  if (header.coordinate) return ReadCoordinate<T>(in, header, options);
+  return S21BasicSparseMatrix<T>(ReadArray<T>(in, header, options));
+}
+
+template <typename T>
+void S21BasicMatrixText<T>::WriteMatrixMarket(
+    std::ostream &out, S21BasicMatrixView<const T> matrix) {
+  std::string block = "%%MatrixMarket matrix array real general\n" +
+                      std::to_string(matrix.get_rows()) + " " +
+                      std::to_string(matrix.get_cols()) + "\n";
+  for (int j = 0; j < matrix.get_cols(); ++j) {
+    for (int i = 0; i < matrix.get_rows(); ++i) {
+      AppendNumber(block, matrix.Coeff(i, j));
+      block += '\n';
+    }
+    Flush(out, block, false);
+  }
+  Flush(out, block, true);
+}
+
+template <typename T>
+void S21BasicMatrixText<T>::WriteMatrixMarket(
+    std::ostream &out, const S21BasicSparseMatrix<T> &matrix) {
+  std::string block = "%%MatrixMarket matrix coordinate real general\n" +
+                      std::to_string(matrix.get_rows()) + " " +
+                      std::to_string(matrix.get_cols()) + " " +
+                      std::to_string(matrix.NonZeros()) + "\n";
+  const bool csr = matrix.get_format() == S21SparseFormat::kCsr;
+  const std::vector<size_t> &ptr = matrix.get_ptr();
+  const std::vector<int> &index = matrix.get_index();
+  const std::vector<T> &values = matrix.get_values();
+  for (size_t outer = 0; outer + 1 < ptr.size(); ++outer) {
+    for (size_t p = ptr[outer]; p < ptr[outer + 1]; ++p) {
+      size_t i = csr ? outer : index[p], j = csr ? index[p] : outer;
+      block += std::to_string(i + 1);
+      block += ' ';
+      block += std::to_string(j + 1);
+      block += ' ';
+      AppendNumber(block, values[p]);
+      block += '\n';
+    }
+    Flush(out, block, false);
+  }
+  Flush(out, block, true);
+}
+
+template class S21BasicMatrixText<float>;
+template class S21BasicMatrixText<double>;
+template class S21BasicMatrixText<long double>;
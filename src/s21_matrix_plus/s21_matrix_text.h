@@ -0,0 +1,67 @@
+#ifndef S21_MATRIX_TEXT
+#define S21_MATRIX_TEXT
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <ostream>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_view.h"
+
+struct S21TextOptions {
+  // CSV value separator. With ' ' or '\t' any run of blanks separates.
+  char delimiter = ',';
+  // CSV: skip the first non-empty line.
+  bool header = false;
+  // Parse the lines of each chunk on S21ThreadPool::Current().
+  bool parallel = false;
+  // Bytes read from the stream at a time; lines are never split.
+  size_t chunk_bytes = size_t(1) << 22;
+};
+
+// CSV and MatrixMarket (.mtx) import and export of real matrices. Input is
+// read in chunks of whole lines, so only one chunk of text is held at a
+// time, and numbers are converted with std::from_chars / std::to_chars:
+// locale independent, and written values read back exactly. Errors throw
+// MatrixException naming the line. Instantiated for float, double and
+// long double.
+template <typename T>
+class S21BasicMatrixText {
+ public:
+  // Receives consecutive rows of the input, a chunk at a time.
+  using RowSink = std::function<void(S21BasicMatrixView<const T> rows)>;
+
+  // Feeds the rows of a CSV stream to `sink` without building a matrix,
+  // for inputs larger than memory. All rows must have as many values as
+  // the first one.
+  static void StreamCsv(std::istream &in, const RowSink &sink,
+                        const S21TextOptions &options = {});
+  static S21BasicMatrix<T> ReadCsv(std::istream &in,
+                                   const S21TextOptions &options = {});
+  static void WriteCsv(std::ostream &out, S21BasicMatrixView<const T> matrix,
+                       char delimiter = ',');
+
+  // Coordinate and array formats with real, integer or pattern fields and
+  // general, symmetric or skew-symmetric storage. Complex and hermitian
+  // files are rejected.
+  static S21BasicMatrix<T> ReadMatrixMarket(std::istream &in,
+                                            const S21TextOptions &options = {});
+  static S21BasicSparseMatrix<T> ReadMatrixMarketSparse(
+      std::istream &in, const S21TextOptions &options = {});
+  // A dense matrix is written in array format, a sparse one in coordinate
+  // format; both as general real matrices.
+  static void WriteMatrixMarket(std::ostream &out,
+                                S21BasicMatrixView<const T> matrix);
+  static void WriteMatrixMarket(std::ostream &out,
+                                const S21BasicSparseMatrix<T> &matrix);
+};
+
+using S21MatrixText = S21BasicMatrixText<double>;
+
+extern template class S21BasicMatrixText<float>;
+extern template class S21BasicMatrixText<double>;
+extern template class S21BasicMatrixText<long double>;
+
+#endif  // S21_MATRIX_TEXT
@@ -0,0 +1,415 @@
+#include "s21_matrix_tiled.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_simd.h"
+
+S21TileCache::S21TileCache(size_t budget_bytes)
+    : budget_(budget_bytes), resident_(0), peak_(0), hits_(0), misses_(0) {}
+
+S21TileCache::~S21TileCache() = default;
+
+size_t S21TileCache::get_budget() const { return budget_; }
+
+size_t S21TileCache::get_resident_bytes() const { return resident_; }
+
+size_t S21TileCache::get_peak_bytes() const { return peak_; }
+
+size_t S21TileCache::get_hits() const { return hits_; }
+
+size_t S21TileCache::get_misses() const { return misses_; }
+
+char *S21TileCache::Pin(int fd, off_t offset, size_t bytes, bool load) {
+  const Key key(fd, offset);
+  auto found = entries_.find(key);
+  if (found != entries_.end()) {
+    ++hits_;
+    Entry &entry = found->second;
+    if (entry.pins++ == 0) lru_.erase(entry.lru);
+    return entry.data.data();
+  }
+  ++misses_;
+  Buffer data = MakeRoom(bytes);
+  if (data.size() != bytes) {
+    data = Buffer(S21AlignedAllocator<char>::Heap());
+    data.resize(bytes);
+  } else if (!load) {
+    std::fill(data.begin(), data.end(), 0);
+  }
+  // Past the end of the file reads as zeros, like the sparse file itself.
+  for (size_t done = 0; load && done < bytes;) {
+    ssize_t n = pread(fd, data.data() + done, bytes - done, offset + done);
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) throw MatrixException("Pin: Cannot read a tile.");
+    if (n == 0) {
+      std::fill(data.begin() + done, data.end(), 0);
+      break;
+    }
+    done += n;
+  }
+  resident_ += bytes;
+  peak_ = std::max(peak_, resident_);
+  Entry &entry = entries_[key];
+  entry.data = std::move(data);
+  entry.dirty = false;
+  entry.pins = 1;
+  return entry.data.data();
+}
+
+void S21TileCache::Unpin(int fd, off_t offset, bool dirty) {
+  const Key key(fd, offset);
+  Entry &entry = entries_.at(key);
+  entry.dirty = entry.dirty || dirty;
+  if (--entry.pins == 0) entry.lru = lru_.insert(lru_.end(), key);
+}
+
+void S21TileCache::Prefetch(int fd, off_t offset, size_t bytes) const {
+  if (entries_.count(Key(fd, offset))) return;
+  posix_fadvise(fd, offset, bytes, POSIX_FADV_WILLNEED);
+}
+
+void S21TileCache::WriteBack(const Key &key, Entry &entry) {
+  if (!entry.dirty) return;
+  const size_t bytes = entry.data.size();
+  for (size_t done = 0; done < bytes;) {
+    ssize_t n = pwrite(key.first, entry.data.data() + done, bytes - done,
+                       key.second + done);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) throw MatrixException("WriteBack: Cannot write a tile.");
+    done += n;
+  }
+  entry.dirty = false;
+}
+
+S21TileCache::Buffer S21TileCache::MakeRoom(size_t bytes) {
+  Buffer reuse(S21AlignedAllocator<char>::Heap());
+  while (resident_ + bytes > budget_) {
+    if (lru_.empty())
+      throw MatrixException(
+          "Pin: Tile cache budget is too small for the pinned tiles.");
+    const Key key = lru_.front();
+    auto victim = entries_.find(key);
+    WriteBack(key, victim->second);
+    resident_ -= victim->second.data.size();
+    if (reuse.empty() && victim->second.data.size() == bytes)
+      reuse = std::move(victim->second.data);
+    lru_.pop_front();
+    entries_.erase(victim);
+  }
+  return reuse;
+}
+
+void S21TileCache::Flush(int fd) {
+  auto it = entries_.lower_bound(Key(fd, std::numeric_limits<off_t>::min()));
+  for (; it != entries_.end() && it->first.first == fd; ++it)
+    WriteBack(it->first, it->second);
+}
+
+// The tiles are forgotten even when a write-back fails, since the file
+// descriptor may be reused for another file right after.
+void S21TileCache::Drop(int fd) {
+  bool failed = false;
+  auto it = entries_.lower_bound(Key(fd, std::numeric_limits<off_t>::min()));
+  while (it != entries_.end() && it->first.first == fd) {
+    try {
+      WriteBack(it->first, it->second);
+    } catch (const MatrixException &) {
+      failed = true;
+    }
+    if (it->second.pins == 0) lru_.erase(it->second.lru);
+    resident_ -= it->second.data.size();
+    it = entries_.erase(it);
+  }
+  if (failed) throw MatrixException("Drop: Cannot write a tile.");
+}
+
+template <typename T>
+S21BasicTiledMatrix<T>::S21BasicTiledMatrix(const std::string &path,
+                                            int rows, int cols,
+                                            S21TileCache &cache, int tile)
+    : cache_(&cache), path_(path), fd_(-1), rows_(rows), cols_(cols),
+      tile_(tile) {
+  if (rows <= 0 || cols <= 0 || tile <= 0)
+    throw MatrixException("TiledMatrix: Matrix cols/rows out of range");
+  tile_rows_ = (rows + tile - 1) / tile;
+  tile_cols_ = (cols + tile - 1) / tile;
+  fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0) throw MatrixException("TiledMatrix: Cannot open " + path);
+  // A sparse file: tiles never written read back as zeros.
+  if (ftruncate(fd_, TileOffset(tile_rows_, 0)) != 0) {
+    close(fd_);
+    throw MatrixException("TiledMatrix: Cannot size " + path);
+  }
+}
+
+template <typename T>
+S21BasicTiledMatrix<T>::S21BasicTiledMatrix(
+    S21BasicTiledMatrix &&other) noexcept
+    : cache_(other.cache_), path_(std::move(other.path_)), fd_(other.fd_),
+      rows_(other.rows_), cols_(other.cols_), tile_(other.tile_),
+      tile_rows_(other.tile_rows_), tile_cols_(other.tile_cols_) {
+  other.fd_ = -1;
+}
+
+template <typename T>
+S21BasicTiledMatrix<T> &S21BasicTiledMatrix<T>::operator=(
+    S21BasicTiledMatrix &&other) noexcept {
+  if (this != &other) {
+    Close();
+    cache_ = other.cache_;
+    path_ = std::move(other.path_);
+    fd_ = std::exchange(other.fd_, -1);
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    tile_ = other.tile_;
+    tile_rows_ = other.tile_rows_;
+    tile_cols_ = other.tile_cols_;
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicTiledMatrix<T>::~S21BasicTiledMatrix() {
+  Close();
+}
+
+// Write errors cannot be reported from here; Flush() first to see them.
+template <typename T>
+void S21BasicTiledMatrix<T>::Close() {
+  if (fd_ < 0) return;
+  try {
+    cache_->Drop(fd_);
+  } catch (const MatrixException &) {
+  }
+  close(fd_);
+  fd_ = -1;
+}
+
+template <typename T>
+size_t S21BasicTiledMatrix<T>::TileBytes() const {
+  return static_cast<size_t>(tile_) * tile_ * sizeof(T);
+}
+
+template <typename T>
+off_t S21BasicTiledMatrix<T>::TileOffset(int ti, int tj) const {
+  return (static_cast<off_t>(ti) * tile_cols_ + tj) *
+         static_cast<off_t>(TileBytes());
+}
+
+template <typename T>
+S21BasicTiledMatrix<T>::TilePin::TilePin(const S21BasicTiledMatrix &matrix,
+                                         int ti, int tj, bool load)
+    : cache_(matrix.cache_), fd_(matrix.fd_),
+      offset_(matrix.TileOffset(ti, tj)), dirty_(false) {
+  data_ = reinterpret_cast<T *>(
+      cache_->Pin(fd_, offset_, matrix.TileBytes(), load));
+}
+
+template <typename T>
+S21BasicTiledMatrix<T>::TilePin::~TilePin() {
+  cache_->Unpin(fd_, offset_, dirty_);
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::PrefetchTile(int ti, int tj) const {
+  if (ti < tile_rows_ && tj < tile_cols_)
+    cache_->Prefetch(fd_, TileOffset(ti, tj), TileBytes());
+}
+
+template <typename T>
+int S21BasicTiledMatrix<T>::get_rows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicTiledMatrix<T>::get_cols() const {
+  return cols_;
+}
+
+template <typename T>
+int S21BasicTiledMatrix<T>::get_tile() const {
+  return tile_;
+}
+
+template <typename T>
+const std::string &S21BasicTiledMatrix<T>::get_path() const {
+  return path_;
+}
+
+template <typename T>
+T S21BasicTiledMatrix<T>::operator()(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("Operator(): Index out of bounds.");
+  const int ti = row / tile_, tj = col / tile_;
+  return TilePin(*this, ti, tj).data()[(row % tile_) * tile_ + col % tile_];
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::set_element(int row, int col, T value) {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw MatrixException("set_element: Index out of range");
+  const int ti = row / tile_, tj = col / tile_;
+  TilePin pin(*this, ti, tj);
+  pin.data()[(row % tile_) * tile_ + col % tile_] = value;
+  pin.MarkDirty();
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::WriteBlock(int row, int col,
+                                        S21BasicMatrixView<const T> block) {
+  const int h = block.get_rows(), w = block.get_cols();
+  if (row < 0 || col < 0 || h <= 0 || w <= 0 || h > rows_ - row ||
+      w > cols_ - col)
+    throw MatrixException("WriteBlock: Block is out of bounds.");
+  for (int ti = row / tile_; ti * tile_ < row + h; ++ti) {
+    for (int tj = col / tile_; tj * tile_ < col + w; ++tj) {
+      PrefetchTile(ti, tj + 1);
+      const int r0 = std::max(row, ti * tile_);
+      const int r1 = std::min(row + h, (ti + 1) * tile_);
+      const int c0 = std::max(col, tj * tile_);
+      const int c1 = std::min(col + w, (tj + 1) * tile_);
+      // A tile the block covers entirely is not read first.
+      const bool whole = r1 - r0 == std::min(tile_, rows_ - ti * tile_) &&
+                         c1 - c0 == std::min(tile_, cols_ - tj * tile_);
+      TilePin tile(*this, ti, tj, !whole);
+      for (int r = r0; r < r1; ++r)
+        std::copy(block.row(r - row) + c0 - col, block.row(r - row) + c1 - col,
+                  tile.data() + (r - ti * tile_) * tile_ + c0 - tj * tile_);
+      tile.MarkDirty();
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicTiledMatrix<T>::ReadBlock(int row, int col, int h,
+                                                    int w) const {
+  if (row < 0 || col < 0 || h <= 0 || w <= 0 || h > rows_ - row ||
+      w > cols_ - col)
+    throw MatrixException("ReadBlock: Block is out of bounds.");
+  S21BasicMatrix<T> result(h, w);
+  for (int ti = row / tile_; ti * tile_ < row + h; ++ti) {
+    for (int tj = col / tile_; tj * tile_ < col + w; ++tj) {
+      PrefetchTile(ti, tj + 1);
+      const int r0 = std::max(row, ti * tile_);
+      const int r1 = std::min(row + h, (ti + 1) * tile_);
+      const int c0 = std::max(col, tj * tile_);
+      const int c1 = std::min(col + w, (tj + 1) * tile_);
+      TilePin tile(*this, ti, tj);
+      for (int r = r0; r < r1; ++r) {
+        const T *src = tile.data() + (r - ti * tile_) * tile_ + c0 - tj * tile_;
+        std::copy(src, src + (c1 - c0),
+                  result.template row<S21UncheckedAccess>(r - row) + c0 - col);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::Flush() {
+  cache_->Flush(fd_);
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::CheckSameShape(const S21BasicTiledMatrix &other,
+                                            const char *message) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_ || tile_ != other.tile_)
+    throw MatrixException(message);
+}
+
+// Tile by tile, in file order; the padding of edge tiles is zero in both
+// operands and stays zero.
+template <typename T>
+template <typename Kernel>
+void S21BasicTiledMatrix<T>::Update(const S21BasicTiledMatrix &other,
+                                    Kernel kernel) {
+  const size_t count = static_cast<size_t>(tile_) * tile_;
+  for (int ti = 0; ti < tile_rows_; ++ti) {
+    for (int tj = 0; tj < tile_cols_; ++tj) {
+      const int ni = tj + 1 < tile_cols_ ? ti : ti + 1;
+      const int nj = tj + 1 < tile_cols_ ? tj + 1 : 0;
+      PrefetchTile(ni, nj);
+      other.PrefetchTile(ni, nj);
+      TilePin dst(*this, ti, tj);
+      TilePin src(other, ti, tj);
+      kernel(dst.data(), src.data(), count);
+      dst.MarkDirty();
+    }
+  }
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::SumMatrix(const S21BasicTiledMatrix &other) {
+  CheckSameShape(other, S21AddOp::kMismatch);
+  Update(other, s21::Simd<T>().add);
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::SubMatrix(const S21BasicTiledMatrix &other) {
+  CheckSameShape(other, S21SubOp::kMismatch);
+  Update(other, s21::Simd<T>().sub);
+}
+
+template <typename T>
+void S21BasicTiledMatrix<T>::MulNumber(T num) {
+  const auto scale = s21::Simd<T>().scale;
+  Update(*this,
+         [&](T *dst, const T *, size_t count) { scale(dst, num, count); });
+}
+
+template <typename T>
+S21BasicTiledMatrix<T> S21BasicTiledMatrix<T>::Transpose(
+    const std::string &path) const {
+  S21BasicTiledMatrix result(path, cols_, rows_, *cache_, tile_);
+  for (int ti = 0; ti < tile_rows_; ++ti) {
+    for (int tj = 0; tj < tile_cols_; ++tj) {
+      PrefetchTile(tj + 1 < tile_cols_ ? ti : ti + 1,
+                   tj + 1 < tile_cols_ ? tj + 1 : 0);
+      TilePin src(*this, ti, tj);
+      TilePin dst(result, tj, ti, false);
+      for (int r = 0; r < tile_; ++r)
+        for (int c = 0; c < tile_; ++c)
+          dst.data()[c * tile_ + r] = src.data()[r * tile_ + c];
+      dst.MarkDirty();
+    }
+  }
+  return result;
+}
+
+// C(i, j) = sum over k of A(i, k) * B(k, j), one output tile at a time:
+// at most three tiles are pinned, and a cache holding a block row of A
+// serves it from memory for every j.
+template <typename T>
+S21BasicTiledMatrix<T> S21BasicTiledMatrix<T>::MulMatrix(
+    const S21BasicTiledMatrix &other, const std::string &path) const {
+  if (cols_ != other.rows_ || tile_ != other.tile_)
+    throw MatrixException(
+        "MulMatrix: Matrices dimensions do not match for multiplication.");
+  S21BasicTiledMatrix result(path, rows_, other.cols_, *cache_, tile_);
+  for (int i = 0; i < tile_rows_; ++i) {
+    for (int j = 0; j < other.tile_cols_; ++j) {
+      TilePin c(result, i, j, false);
+      for (int k = 0; k < tile_cols_; ++k) {
+        PrefetchTile(i, k + 1);
+        other.PrefetchTile(k + 1, j);
+        TilePin a(*this, i, k), b(other, k, j);
+        s21::Gemm(tile_, tile_, tile_, T(1), a.data(), tile_, b.data(), tile_,
+                  c.data(), tile_, k > 0);
+      }
+      c.MarkDirty();
+    }
+  }
+  return result;
+}
+
+template class S21BasicTiledMatrix<float>;
+template class S21BasicTiledMatrix<double>;
+template class S21BasicTiledMatrix<long double>;
+template class S21BasicTiledMatrix<std::complex<double>>;
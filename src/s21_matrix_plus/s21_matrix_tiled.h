@@ -0,0 +1,161 @@
+#ifndef S21_MATRIX_TILED
+#define S21_MATRIX_TILED
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_view.h"
+
+// Tiles of disk-backed matrices held in memory, least recently used first
+// out. Everything a tiled matrix reads or writes goes through the cache it
+// was created with, and the cache never holds more than get_budget()
+// bytes of tiles: a miss evicts unpinned tiles, writing dirty ones back,
+// until the new tile fits. Several matrices may share one cache, which
+// then bounds the memory of every operation between them. Not
+// thread-safe, and it must outlive the matrices using it.
+class S21TileCache {
+ public:
+  explicit S21TileCache(size_t budget_bytes);
+  S21TileCache(const S21TileCache &) = delete;
+  S21TileCache &operator=(const S21TileCache &) = delete;
+  ~S21TileCache();
+
+  size_t get_budget() const;
+  size_t get_resident_bytes() const;
+  // Highest get_resident_bytes() seen so far.
+  size_t get_peak_bytes() const;
+  size_t get_hits() const;
+  size_t get_misses() const;
+
+  // The block of `bytes` at `offset` of the file `fd`, read in on a miss
+  // unless `load` is false (the caller overwrites it; it starts zeroed).
+  // A pinned tile is never evicted; every Pin needs one Unpin, with
+  // `dirty` set when the tile was modified.
+  char *Pin(int fd, off_t offset, size_t bytes, bool load = true);
+  void Unpin(int fd, off_t offset, bool dirty);
+  // Asks the kernel to start reading a block the caller will Pin soon, so
+  // the read overlaps the work on the current tiles. Costs no budget.
+  void Prefetch(int fd, off_t offset, size_t bytes) const;
+  // Writes back the dirty tiles of `fd`; Drop also forgets its tiles.
+  void Flush(int fd);
+  void Drop(int fd);
+
+ private:
+  using Key = std::pair<int, off_t>;
+  using Buffer = std::vector<char, S21AlignedAllocator<char>>;
+  struct Entry {
+    Buffer data;
+    bool dirty;
+    int pins;
+    std::list<Key>::iterator lru;
+  };
+
+  size_t budget_, resident_, peak_, hits_, misses_;
+  std::map<Key, Entry> entries_;
+  // Unpinned tiles, least recently used at the front.
+  std::list<Key> lru_;
+
+  void WriteBack(const Key &key, Entry &entry);
+  // Evicts until `bytes` more fit; returns a buffer of an evicted tile of
+  // exactly that size when there was one, for reuse.
+  Buffer MakeRoom(size_t bytes);
+};
+
+// rows x cols matrix kept in a file as square tiles of get_tile() x
+// get_tile() elements, each stored contiguously and row-major (edge tiles
+// padded with zeros), so any tile is one read. Only the tiles in the cache
+// are in memory, so the matrix can be far larger than RAM; the operations
+// below stream tiles through the cache, prefetching the next ones while
+// computing on the current ones.
+//
+// The constructor creates (or truncates) the file; it is left on disk.
+// Operations producing a new matrix take the path of its file.
+template <typename T>
+class S21BasicTiledMatrix {
+ public:
+  static constexpr int kDefaultTile = 256;
+
+ private:
+  S21TileCache *cache_;
+  std::string path_;
+  int fd_;
+  int rows_, cols_, tile_, tile_rows_, tile_cols_;
+
+  // Tile (ti, tj) pinned in the cache for the lifetime of the object.
+  class TilePin {
+   public:
+    TilePin(const S21BasicTiledMatrix &matrix, int ti, int tj,
+            bool load = true);
+    TilePin(const TilePin &) = delete;
+    TilePin &operator=(const TilePin &) = delete;
+    ~TilePin();
+    T *data() const { return data_; }
+    void MarkDirty() { dirty_ = true; }
+
+   private:
+    S21TileCache *cache_;
+    int fd_;
+    off_t offset_;
+    T *data_;
+    bool dirty_;
+  };
+
+  size_t TileBytes() const;
+  off_t TileOffset(int ti, int tj) const;
+  void PrefetchTile(int ti, int tj) const;
+  void CheckSameShape(const S21BasicTiledMatrix &other,
+                      const char *message) const;
+  template <typename Kernel>
+  void Update(const S21BasicTiledMatrix &other, Kernel kernel);
+  void Close();
+
+ public:
+  S21BasicTiledMatrix(const std::string &path, int rows, int cols,
+                      S21TileCache &cache, int tile = kDefaultTile);
+  S21BasicTiledMatrix(S21BasicTiledMatrix &&other) noexcept;
+  S21BasicTiledMatrix &operator=(S21BasicTiledMatrix &&other) noexcept;
+  S21BasicTiledMatrix(const S21BasicTiledMatrix &) = delete;
+  S21BasicTiledMatrix &operator=(const S21BasicTiledMatrix &) = delete;
+  // Writes back the dirty tiles and closes the file.
+  ~S21BasicTiledMatrix();
+
+  int get_rows() const;
+  int get_cols() const;
+  int get_tile() const;
+  const std::string &get_path() const;
+
+  T operator()(int row, int col) const;
+  void set_element(int row, int col, T value);
+  // Copies `block` in with its top left corner at (row, col), or the
+  // h x w block at (row, col) out.
+  void WriteBlock(int row, int col, S21BasicMatrixView<const T> block);
+  S21BasicMatrix<T> ReadBlock(int row, int col, int h, int w) const;
+  // Writes all dirty tiles back to the file.
+  void Flush();
+
+  void SumMatrix(const S21BasicTiledMatrix &other);
+  void SubMatrix(const S21BasicTiledMatrix &other);
+  void MulNumber(T num);
+  // The operands must have the same tile size; the result uses it too.
+  S21BasicTiledMatrix Transpose(const std::string &path) const;
+  S21BasicTiledMatrix MulMatrix(const S21BasicTiledMatrix &other,
+                                const std::string &path) const;
+};
+
+using S21TiledMatrix = S21BasicTiledMatrix<double>;
+
+extern template class S21BasicTiledMatrix<float>;
+extern template class S21BasicTiledMatrix<double>;
+extern template class S21BasicTiledMatrix<long double>;
+extern template class S21BasicTiledMatrix<std::complex<double>>;
+
+#endif  // S21_MATRIX_TILED
@@ -0,0 +1,47 @@
+#ifndef S21_MATRIX_TRAITS
+#define S21_MATRIX_TRAITS
+
+#include <complex>
+#include <limits>
+#include <type_traits>
+
+// Per element type constants of S21BasicMatrix. Only the types specialized
+// here are supported: float, double, long double and std::complex of them.
+// Real is the type of magnitudes (|x|, norms, tolerances); kEpsilon is the
+// tolerance EqMatrix compares elements with.
+template <typename T>
+struct S21MatrixTraits;
+
+template <>
+struct S21MatrixTraits<float> {
+  using Real = float;
+  static constexpr Real kEpsilon = 1e-5f;
+};
+
+template <>
+struct S21MatrixTraits<double> {
+  using Real = double;
+  static constexpr Real kEpsilon = 1e-7;
+};
+
+template <>
+struct S21MatrixTraits<long double> {
+  using Real = long double;
+  static constexpr Real kEpsilon = 1e-9L;
+};
+
+template <typename T>
+struct S21MatrixTraits<std::complex<T>> {
+  using Real = T;
+  static constexpr Real kEpsilon = S21MatrixTraits<T>::kEpsilon;
+};
+
+// Types an expression can be scaled by: the element types above and any
+// arithmetic type, which converts to the element type of the expression.
+template <typename T, typename = void>
+struct S21IsScalar : std::is_arithmetic<T> {};
+template <typename T>
+struct S21IsScalar<T, std::void_t<typename S21MatrixTraits<T>::Real>>
+    : std::true_type {};
+
+#endif  // S21_MATRIX_TRAITS
@@ -0,0 +1,247 @@
+#ifndef S21_MATRIX_VIEW
+#define S21_MATRIX_VIEW
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_traits.h"
+
+// Non-owning views into the storage of a matrix. They are a pointer, a
+// shape and a row stride, so they are cheap to create and pass by value,
+// and they are valid only as long as the viewed storage is neither
+// destroyed nor reallocated (set_rows(), set_cols(), assigning a matrix of
+// another shape).
+
+template <typename T>
+class S21MinorView;
+
+// True when [begin, end) and the elements of a view overlap.
+inline bool S21Overlaps(const void *view_begin, const void *view_end,
+                        const void *begin, const void *end) {
+  std::less<const void *> less;
+  return less(view_begin, end) && less(begin, view_end);
+}
+
+// Rows x cols elements starting at data, rows being stride elements apart.
+// S21BasicMatrixView<T> can read and write the elements, and
+// S21BasicMatrixView<const T> only read them. Copying a view copies the
+// reference; assigning to a view writes the elements, like assigning to
+// the block of the matrix it refers to.
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ public:
+  using value_type = std::remove_const_t<T>;
+  using Real = typename S21MatrixTraits<value_type>::Real;
+
+ private:
+  T *data_;
+  int rows_, cols_, stride_;
+
+  size_t Offset(int row, int col) const {
+    return static_cast<size_t>(row) * stride_ + col;
+  }
+  const T *end() const {
+    return rows_ && cols_ ? data_ + Offset(rows_ - 1, cols_) : data_;
+  }
+  void CheckShape(int rows, int cols, const char *message) const {
+    if (rows != rows_ || cols != cols_) throw MatrixException(message);
+  }
+  // Applies kernel(dst_row, src_row, cols) row by row when the source
+  // exposes rows, and falls back to op(dst, coeff) element by element.
+  template <typename E, typename Kernel, typename Op>
+  void Update(const E &expr, Kernel kernel, Op op) {
+    if (expr.ReadsShifted(data_, end())) {
+      Update(S21BasicMatrix<value_type>(expr), kernel, op);
+    } else if constexpr (std::is_same<E, S21BasicMatrix<value_type>>::value ||
+                         std::is_same<E, S21BasicMatrixView<T>>::value ||
+                         std::is_same<E, S21BasicMatrixView<const T>>::value) {
+      for (int i = 0; i < rows_; ++i) kernel(row(i), expr.row(i), cols_);
+    } else {
+      for (int i = 0; i < rows_; ++i)
+        for (int j = 0; j < cols_; ++j)
+          op(data_[Offset(i, j)], expr.Coeff(i, j));
+    }
+  }
+
+ public:
+  S21BasicMatrixView(T *data, int rows, int cols, int stride)
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+  // The whole of a matrix. A const or temporary matrix only gives a
+  // read-only view, which must not outlive the temporary.
+  template <typename M, typename D = std::remove_reference_t<M>,
+            typename = std::enable_if_t<
+                std::is_same<std::remove_const_t<D>,
+                             S21BasicMatrix<value_type>>::value &&
+                (std::is_const<T>::value ||
+                 (std::is_lvalue_reference<M>::value &&
+                  !std::is_const<D>::value))>>
+  S21BasicMatrixView(M &&matrix)
+      : S21BasicMatrixView(matrix.data(), matrix.get_rows(), matrix.get_cols(),
+                           matrix.get_stride()) {}
+  // A writable view converts to a read-only one.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_const<T>::value &&
+                            std::is_same<const U, T>::value>>
+  S21BasicMatrixView(const S21BasicMatrixView<U> &other)
+      : S21BasicMatrixView(other.data(), other.get_rows(), other.get_cols(),
+                           other.get_stride()) {}
+  S21BasicMatrixView(const S21BasicMatrixView &other) = default;
+
+  int get_rows() const { return rows_; }
+  int get_cols() const { return cols_; }
+  int get_stride() const { return stride_; }
+  T *data() const { return data_; }
+  T *row(int i) const { return data_ + Offset(i, 0); }
+
+  value_type Coeff(int row, int col) const { return data_[Offset(row, col)]; }
+  // A view may overlap the destination at another position, as a block
+  // shifted inside its own matrix does.
+  bool ReadsShifted(const void *begin, const void *end) const {
+    return S21Overlaps(data_, this->end(), begin, end);
+  }
+  T &operator()(int row, int col) const {
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+      throw MatrixException("Operator(): Index out of bounds.");
+    return data_[Offset(row, col)];
+  }
+
+  S21BasicMatrixView Block(int r, int c, int h, int w) const {
+    if (r < 0 || c < 0 || h < 0 || w < 0 || r + h > rows_ || c + w > cols_)
+      throw MatrixException("Block: Block is out of bounds.");
+    return S21BasicMatrixView(data_ + Offset(r, c), h, w, stride_);
+  }
+  S21BasicMatrixView Row(int i) const {
+    if (i < 0 || i >= rows_) throw MatrixException("Row: Index out of bounds.");
+    return S21BasicMatrixView(row(i), 1, cols_, stride_);
+  }
+  S21BasicMatrixView Col(int j) const {
+    if (j < 0 || j >= cols_) throw MatrixException("Col: Index out of bounds.");
+    return S21BasicMatrixView(data_ + j, rows_, 1, stride_);
+  }
+  S21MinorView<value_type> MinorView(int r, int c) const {
+    return S21MinorView<value_type>(data_, rows_, cols_, stride_, r, c);
+  }
+
+  template <typename E>
+  bool EqMatrix(const S21MatrixExpr<E> &other) const {
+    if (other.get_rows() != rows_ || other.get_cols() != cols_) return false;
+    for (int i = 0; i < rows_; ++i)
+      for (int j = 0; j < cols_; ++j)
+        if (std::abs(Coeff(i, j) - other.Coeff(i, j)) >
+            S21MatrixTraits<value_type>::kEpsilon)
+          return false;
+    return true;
+  }
+
+  // The in-place operations below write through the view, so they only
+  // compile for views of non-const elements.
+  S21BasicMatrixView &operator=(const S21BasicMatrixView &other) {
+    return *this = static_cast<const S21MatrixExpr<S21BasicMatrixView> &>(
+               other);
+  }
+  template <typename E>
+  S21BasicMatrixView &operator=(const S21MatrixExpr<E> &expr) {
+    CheckShape(expr.get_rows(), expr.get_cols(),
+               "Operator=: Matrices dimensions do not match.");
+    Update(
+        expr.self(),
+        [](T *dst, const auto *src, size_t n) {
+          std::copy(src, src + n, dst);
+        },
+        [](T &dst, const value_type &src) { dst = src; });
+    return *this;
+  }
+  template <typename E>
+  S21BasicMatrixView &operator+=(const S21MatrixExpr<E> &expr) {
+    CheckShape(expr.get_rows(), expr.get_cols(), S21AddOp::kMismatch);
+    Update(
+        expr.self(),
+        [](T *dst, const value_type *src, size_t n) {
+          s21::Simd<value_type>().add(dst, src, n);
+        },
+        [](T &dst, const value_type &src) { dst += src; });
+    return *this;
+  }
+  template <typename E>
+  S21BasicMatrixView &operator-=(const S21MatrixExpr<E> &expr) {
+    CheckShape(expr.get_rows(), expr.get_cols(), S21SubOp::kMismatch);
+    Update(
+        expr.self(),
+        [](T *dst, const value_type *src, size_t n) {
+          s21::Simd<value_type>().sub(dst, src, n);
+        },
+        [](T &dst, const value_type &src) { dst -= src; });
+    return *this;
+  }
+  S21BasicMatrixView &operator*=(const value_type &num) {
+    for (int i = 0; i < rows_; ++i)
+      s21::Simd<value_type>().scale(row(i), num, cols_);
+    return *this;
+  }
+  // this += alpha * other in a single fused pass.
+  template <typename E>
+  void Axpy(value_type alpha, const S21MatrixExpr<E> &other) {
+    CheckShape(other.get_rows(), other.get_cols(), S21AddOp::kMismatch);
+    Update(
+        other.self(),
+        [alpha](T *dst, const value_type *src, size_t n) {
+          s21::Simd<value_type>().axpy(dst, alpha, src, n);
+        },
+        [alpha](T &dst, const value_type &src) { dst += alpha * src; });
+  }
+};
+
+// The matrix left after deleting row r and column c of the viewed one,
+// read in place: element (i, j) maps past the deleted row and column
+// instead of being copied into a new matrix. Read-only; it can be indexed
+// or used as an expression operand.
+template <typename T>
+class S21MinorView : public S21MatrixExpr<S21MinorView<T>> {
+ public:
+  using value_type = T;
+
+ private:
+  const T *data_;
+  int rows_, cols_, stride_, r_, c_;
+
+  size_t Offset(int row, int col) const {
+    return static_cast<size_t>(row + (row >= r_)) * stride_ + col +
+           (col >= c_);
+  }
+
+ public:
+  // rows and cols are those of the viewed matrix.
+  S21MinorView(const T *data, int rows, int cols, int stride, int r, int c)
+      : data_(data), rows_(rows - 1), cols_(cols - 1), stride_(stride),
+        r_(r), c_(c) {
+    if (rows <= 1 || cols <= 1)
+      throw MatrixException(
+          "Minor: Matrix dimensions must be greater than 1 for minors.");
+    if (r < 0 || r >= rows || c < 0 || c >= cols)
+      throw MatrixException("Minor: Index out of bounds.");
+  }
+
+  int get_rows() const { return rows_; }
+  int get_cols() const { return cols_; }
+  T Coeff(int row, int col) const { return data_[Offset(row, col)]; }
+  T operator()(int row, int col) const {
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+      throw MatrixException("Operator(): Index out of bounds.");
+    return data_[Offset(row, col)];
+  }
+  bool ReadsShifted(const void *begin, const void *end) const {
+    return S21Overlaps(data_, data_ + Offset(rows_ - 1, cols_), begin, end);
+  }
+};
+
+template <typename T>
+using S21ConstMatrixView = S21BasicMatrixView<const T>;
+using S21MatrixView = S21BasicMatrixView<double>;
+
+#endif  // S21_MATRIX_VIEW
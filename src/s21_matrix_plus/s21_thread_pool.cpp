@@ -0,0 +1,180 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "s21_matrix_exception.h"
+
+namespace {
+// Pool installed by S21ThreadPoolScope on this thread, if any.
+thread_local S21ThreadPool *tls_current = nullptr;
+// Pool and queue index of this thread when it is a pool worker.
+thread_local S21ThreadPool *tls_owner = nullptr;
+thread_local int tls_index = -1;
+
+// Below this many elements splitting costs more than it saves.
+constexpr size_t kDefaultSerialThreshold = 1 << 16;
+// Chunks per participating thread, so that stealing can even out the load.
+constexpr int64_t kChunksPerThread = 4;
+}  // namespace
+
+S21ThreadPool::S21ThreadPool(int threads)
+    : serial_threshold_(kDefaultSerialThreshold),
+      queued_(0),
+      next_queue_(0),
+      stop_(false) {
+  Start(threads);
+}
+
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+S21ThreadPool &S21ThreadPool::Default() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+S21ThreadPool &S21ThreadPool::Current() {
+  if (tls_current) return *tls_current;
+  if (tls_owner) return *tls_owner;
+  return Default();
+}
+
+int S21ThreadPool::get_thread_count() const {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+void S21ThreadPool::set_thread_count(int threads) {
+  Stop();
+  Start(threads);
+}
+
+size_t S21ThreadPool::get_serial_threshold() const {
+  return serial_threshold_.load(std::memory_order_relaxed);
+}
+
+void S21ThreadPool::set_serial_threshold(size_t elements) {
+  serial_threshold_.store(elements, std::memory_order_relaxed);
+}
+
+bool S21ThreadPool::IsParallel(size_t elements) const {
+  return !workers_.empty() && elements >= get_serial_threshold();
+}
+
+void S21ThreadPool::Start(int threads) {
+  if (threads < 0)
+    throw MatrixException("S21ThreadPool: Thread count must not be negative.");
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  stop_ = false;
+  for (int i = 0; i < threads - 1; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+  for (int i = 0; i < threads - 1; ++i)
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, i);
+}
+
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+  workers_.clear();
+  queues_.clear();
+  queued_ = 0;
+}
+
+void S21ThreadPool::Push(std::function<void()> task) {
+  int index = tls_owner == this
+                  ? tls_index
+                  : static_cast<int>(next_queue_++ % queues_.size());
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  sleep_cv_.notify_one();
+}
+
+// Runs one queued task: the newest one of our own queue if we are a
+// worker, otherwise the oldest one stolen from another queue.
+bool S21ThreadPool::TryRunOne() {
+  if (queued_.load() == 0) return false;
+  std::function<void()> task;
+  int count = static_cast<int>(queues_.size());
+  int self = tls_owner == this ? tls_index : -1;
+  if (self >= 0) {
+    Queue &own = *queues_[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+    }
+  }
+  for (int k = 0; !task && k < count; ++k) {
+    Queue &victim = *queues_[(self + 1 + k) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+    }
+  }
+  if (!task) return false;
+  queued_.fetch_sub(1);
+  task();
+  return true;
+}
+
+void S21ThreadPool::WorkerLoop(int index) {
+  tls_owner = this;
+  tls_index = index;
+  for (;;) {
+    if (TryRunOne()) continue;
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    if (stop_) break;
+    sleep_cv_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+  }
+  tls_owner = nullptr;
+  tls_index = -1;
+}
+
+void S21ThreadPool::ParallelFor(int64_t count, int64_t grain, const Range &fn) {
+  if (count <= 0) return;
+  grain = std::max<int64_t>(grain, 1);
+  int64_t chunks = std::min<int64_t>(
+      count / grain, get_thread_count() * kChunksPerThread);
+  if (workers_.empty() || chunks <= 1) {
+    fn(0, count);
+    return;
+  }
+  std::atomic<int64_t> remaining(chunks);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  int64_t step = count / chunks, extra = count % chunks;
+  for (int64_t c = 0, begin = 0; c < chunks; ++c) {
+    int64_t end = begin + step + (c < extra ? 1 : 0);
+    Push([&, begin, end] {
+      try {
+        fn(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+      }
+      remaining.fetch_sub(1);
+    });
+    begin = end;
+  }
+  while (remaining.load() > 0)
+    if (!TryRunOne()) std::this_thread::yield();
+  if (error) std::rethrow_exception(error);
+}
+
+S21ThreadPoolScope::S21ThreadPoolScope(S21ThreadPool &pool)
+    : previous_(tls_current) {
+  tls_current = &pool;
+}
+
+S21ThreadPoolScope::~S21ThreadPoolScope() { tls_current = previous_; }
@@ -0,0 +1,100 @@
+#ifndef S21_THREAD_POOL
+#define S21_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool used to split large matrix operations into row
+// or tile tasks. Every worker owns a task deque: it pops its own tasks LIFO
+// and steals from the other deques FIFO when it runs dry. A thread waiting
+// for a ParallelFor keeps executing queued tasks, so nested parallel loops
+// cannot deadlock.
+//
+// Matrix operations run on S21ThreadPool::Current(): the pool installed by
+// the innermost S21ThreadPoolScope of the calling thread, or Default().
+class S21ThreadPool {
+ public:
+  using Range = std::function<void(int64_t begin, int64_t end)>;
+
+  // `threads` counts the calling thread too: a pool of 1 runs everything
+  // serially on the caller. 0 means std::thread::hardware_concurrency().
+  explicit S21ThreadPool(int threads = 0);
+  S21ThreadPool(const S21ThreadPool &) = delete;
+  S21ThreadPool &operator=(const S21ThreadPool &) = delete;
+  ~S21ThreadPool();
+
+  static S21ThreadPool &Default();
+  static S21ThreadPool &Current();
+
+  int get_thread_count() const;
+  // Restarts the workers. Must not be called while work is in flight.
+  void set_thread_count(int threads);
+
+  // Operations on fewer elements than this run serially.
+  size_t get_serial_threshold() const;
+  void set_serial_threshold(size_t elements);
+  bool IsParallel(size_t elements) const;
+
+  // Calls fn on disjoint subranges covering [0, count), each at least
+  // `grain` long unless count itself is shorter, and returns when all are
+  // done.
+  // The first exception thrown by fn is rethrown here.
+  void ParallelFor(int64_t count, int64_t grain, const Range &fn);
+
+  // Splits [0, count) over Current() when an operation touching `elements`
+  // values is worth parallelizing there, calls fn(0, count) otherwise.
+  // fn is only wrapped into a Range on the parallel path, so the serial
+  // path never allocates.
+  template <typename Fn>
+  static void ForRange(int64_t count, size_t elements, const Fn &fn) {
+    S21ThreadPool &pool = Current();
+    if (pool.IsParallel(elements))
+      pool.ParallelFor(count, 1, fn);
+    else if (count > 0)
+      fn(0, count);
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> serial_threshold_;
+  std::atomic<int64_t> queued_;
+  std::atomic<unsigned> next_queue_;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stop_;
+
+  void Start(int threads);
+  void Stop();
+  void Push(std::function<void()> task);
+  bool TryRunOne();
+  void WorkerLoop(int index);
+};
+
+// Makes `pool` the current pool of the calling thread for the lifetime of
+// the scope, overriding the default for the calls made inside it.
+class S21ThreadPoolScope {
+ public:
+  explicit S21ThreadPoolScope(S21ThreadPool &pool);
+  S21ThreadPoolScope(const S21ThreadPoolScope &) = delete;
+  S21ThreadPoolScope &operator=(const S21ThreadPoolScope &) = delete;
+  ~S21ThreadPoolScope();
+
+ private:
+  S21ThreadPool *previous_;
+};
+
+#endif  // S21_THREAD_POOL